@@ -0,0 +1,578 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+//  :           .
+//       ,      .
+//     std::pmr::memory_resource,    ArenaAllocator
+class MonotonicArena final : public std::pmr::memory_resource {
+public:
+    explicit MonotonicArena(size_t initial_block_size = 4096,
+        std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept;
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena() override;
+
+    void* Allocate(size_t bytes, size_t alignment);
+    //    ,     Release
+    void Deallocate(void* /*ptr*/, size_t /*bytes*/, size_t /*alignment*/) noexcept {
+    }
+    //      ,       
+    bool TryExpand(void* ptr, size_t old_bytes, size_t new_bytes, size_t alignment) noexcept;
+
+    //     
+    void Release() noexcept;
+
+    //  ,       Release
+    size_t BytesAllocated() const noexcept;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    //  ,    
+    struct Block {
+        Block* next;
+        size_t size;
+    };
+
+    void AddBlock(size_t min_bytes);
+
+    std::pmr::memory_resource* upstream_;
+    size_t initial_block_size_;
+    size_t next_block_size_;
+    Block* blocks_ = nullptr;
+    char* current_ = nullptr;
+    char* end_ = nullptr;
+    size_t bytes_allocated_ = 0;
+};
+
+//    :       MIN_CLASS  MAX_CLASS 
+//      ,     .
+//   ,       Release
+class PoolResource final : public std::pmr::memory_resource {
+public:
+    static constexpr size_t MIN_CLASS = 16;
+    static constexpr size_t MAX_CLASS = 4096;
+
+    explicit PoolResource(size_t chunk_size = 64 * 1024,
+        std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept;
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    ~PoolResource() override;
+
+    void* Allocate(size_t bytes, size_t alignment);
+    void Deallocate(void* ptr, size_t bytes, size_t alignment) noexcept;
+    //    ,        
+    bool TryExpand(void* ptr, size_t old_bytes, size_t new_bytes, size_t alignment) noexcept;
+
+    //    ,   
+    void Release() noexcept;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    static constexpr size_t NUM_CLASSES = 9;  // 16, 32, ..., 4096
+
+    struct FreeCell {
+        FreeCell* next;
+    };
+
+    //    ,       
+    struct LargeBlock {
+        LargeBlock* prev;
+        LargeBlock* next;
+        size_t bytes;
+        size_t alignment;
+    };
+
+    struct Chunk {
+        Chunk* next;
+    };
+
+    //     MIN_CLASS,      
+    // ,   MIN_CLASS,        MAX_CLASS
+    static constexpr size_t CHUNK_ALIGNMENT = alignof(std::max_align_t) > MIN_CLASS ? alignof(std::max_align_t) : MIN_CLASS;
+    static constexpr size_t CHUNK_HEADER_SIZE = (sizeof(Chunk) + MIN_CLASS - 1) / MIN_CLASS * MIN_CLASS;
+    static constexpr size_t MIN_CHUNK_SIZE = CHUNK_HEADER_SIZE + MAX_CLASS;
+
+    static size_t ClassIndex(size_t bytes) noexcept;
+    static size_t LargeHeaderSize(size_t alignment) noexcept;
+    void* AllocateLarge(size_t bytes, size_t alignment);
+    void DeallocateLarge(void* ptr, size_t bytes, size_t alignment) noexcept;
+    void Refill(size_t index);
+
+    std::pmr::memory_resource* upstream_;
+    size_t chunk_size_;
+    FreeCell* free_lists_[NUM_CLASSES] = {};
+    Chunk* chunks_ = nullptr;
+    char* current_ = nullptr;
+    char* end_ = nullptr;
+    LargeBlock* large_blocks_ = nullptr;
+};
+
+//        Resource (MonotonicArena  PoolResource).
+//   ,   .    
+//   ,            
+template <typename T, typename Resource>
+class ResourceAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    template <typename U>
+    struct rebind {
+        using other = ResourceAllocator<U, Resource>;
+    };
+
+    explicit ResourceAllocator(Resource& resource) noexcept
+        : resource_(&resource) {
+    }
+
+    template <typename U>
+    ResourceAllocator(const ResourceAllocator<U, Resource>& other) noexcept
+        : resource_(other.GetResource()) {
+    }
+
+    T* allocate(size_t n) {
+        if (n > static_cast<size_t>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(resource_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        resource_->Deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+
+    bool TryExpand(T* ptr, size_t old_n, size_t new_n) noexcept {
+        if (new_n > static_cast<size_t>(-1) / sizeof(T)) {
+            return false;
+        }
+        return resource_->TryExpand(ptr, old_n * sizeof(T), new_n * sizeof(T), alignof(T));
+    }
+
+    Resource* GetResource() const noexcept {
+        return resource_;
+    }
+
+    template <typename U>
+    bool operator==(const ResourceAllocator<U, Resource>& other) const noexcept {
+        return resource_ == other.GetResource();
+    }
+
+    template <typename U>
+    bool operator!=(const ResourceAllocator<U, Resource>& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    Resource* resource_;
+};
+
+//   malloc/realloc.       
+//   realloc,      ,    
+// (glibc)    mremap       
+template <typename T>
+class MallocAllocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "malloc does not support over-aligned types");
+
+    //      PTRDIFF_MAX .     
+    // malloc/realloc,   ,      
+    static constexpr size_t MAX_BYTES = static_cast<size_t>(PTRDIFF_MAX);
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    MallocAllocator() noexcept = default;
+
+    template <typename U>
+    MallocAllocator(const MallocAllocator<U>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        if (n > MAX_BYTES / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        const size_t bytes = n * sizeof(T);
+        void* ptr = std::malloc(bytes);
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t /*n*/) noexcept {
+        std::free(ptr);
+    }
+
+    T* Reallocate(T* ptr, size_t /*old_n*/, size_t new_n) {
+        if (new_n > MAX_BYTES / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        const size_t bytes = new_n * sizeof(T);
+        void* new_ptr = std::realloc(static_cast<void*>(ptr), bytes);
+        if (new_ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(new_ptr);
+    }
+
+    template <typename U>
+    bool operator==(const MallocAllocator<U>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const MallocAllocator<U>& /*other*/) const noexcept {
+        return false;
+    }
+};
+
+// ,  ,    Alignment  (   alignof(T)),
+//  32  64    AVX       -.
+//  PadCapacity   ,        Alignment 
+template <typename T, size_t Alignment = 64, bool PadCapacity = false>
+class AlignedAllocator {
+public:
+    static constexpr size_t ALIGNMENT = Alignment < alignof(T) ? alignof(T) : Alignment;
+    static_assert((ALIGNMENT & (ALIGNMENT - 1)) == 0, "Alignment must be a power of two");
+
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment, PadCapacity>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment, PadCapacity>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        if (n > static_cast<size_t>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ ALIGNMENT }));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        ::operator delete(static_cast<void*>(ptr), n * sizeof(T), std::align_val_t{ ALIGNMENT });
+    }
+
+    // ,   ,   n 
+    static size_t GoodCapacity(size_t n) noexcept {
+        if constexpr (PadCapacity) {
+            if (n > (static_cast<size_t>(-1) - ALIGNMENT) / sizeof(T)) {
+                return n;
+            }
+            const size_t bytes = (n * sizeof(T) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+            return bytes / sizeof(T);
+        }
+        else {
+            return n;
+        }
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment, PadCapacity>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment, PadCapacity>& /*other*/) const noexcept {
+        return false;
+    }
+};
+
+template <typename T>
+using ArenaAllocator = ResourceAllocator<T, MonotonicArena>;
+
+template <typename T>
+using PoolAllocator = ResourceAllocator<T, PoolResource>;
+
+namespace detail {
+
+    inline char* AlignUp(char* ptr, size_t alignment) noexcept {
+        const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+        return ptr + ((alignment - address % alignment) % alignment);
+    }
+
+}  // namespace detail
+
+inline MonotonicArena::MonotonicArena(size_t initial_block_size, std::pmr::memory_resource* upstream) noexcept
+    : upstream_(upstream)
+    , initial_block_size_(initial_block_size < 2 * sizeof(Block) ? 2 * sizeof(Block) : initial_block_size)
+    , next_block_size_(initial_block_size_)
+{
+}
+
+inline MonotonicArena::~MonotonicArena()
+{
+    Release();
+}
+
+inline void* MonotonicArena::Allocate(size_t bytes, size_t alignment)
+{
+    char* result = detail::AlignUp(current_, alignment);
+    if (current_ == nullptr || result > end_ || static_cast<size_t>(end_ - result) < bytes)
+    {
+        AddBlock(bytes + alignment);
+        result = detail::AlignUp(current_, alignment);
+    }
+    current_ = result + bytes;
+    bytes_allocated_ += bytes;
+    return result;
+}
+
+inline bool MonotonicArena::TryExpand(void* ptr, size_t old_bytes, size_t new_bytes, size_t /*alignment*/) noexcept
+{
+    char* begin = static_cast<char*>(ptr);
+    if (begin + old_bytes != current_ || static_cast<size_t>(end_ - begin) < new_bytes)
+    {
+        return false;
+    }
+    current_ = begin + new_bytes;
+    bytes_allocated_ += new_bytes - old_bytes;
+    return true;
+}
+
+inline void MonotonicArena::Release() noexcept
+{
+    while (blocks_ != nullptr)
+    {
+        Block* next = blocks_->next;
+        upstream_->deallocate(blocks_, blocks_->size, alignof(std::max_align_t));
+        blocks_ = next;
+    }
+    current_ = end_ = nullptr;
+    next_block_size_ = initial_block_size_;
+    bytes_allocated_ = 0;
+}
+
+inline size_t MonotonicArena::BytesAllocated() const noexcept
+{
+    return bytes_allocated_;
+}
+
+inline void MonotonicArena::AddBlock(size_t min_bytes)
+{
+    size_t size = next_block_size_;
+    while (size - sizeof(Block) < min_bytes)
+    {
+        size *= 2;
+    }
+    auto* block = static_cast<Block*>(upstream_->allocate(size, alignof(std::max_align_t)));
+    block->next = blocks_;
+    block->size = size;
+    blocks_ = block;
+    current_ = reinterpret_cast<char*>(block) + sizeof(Block);
+    end_ = reinterpret_cast<char*>(block) + size;
+    next_block_size_ = size * 2;
+}
+
+inline void* MonotonicArena::do_allocate(size_t bytes, size_t alignment)
+{
+    return Allocate(bytes, alignment);
+}
+
+inline void MonotonicArena::do_deallocate(void* ptr, size_t bytes, size_t alignment)
+{
+    Deallocate(ptr, bytes, alignment);
+}
+
+inline bool MonotonicArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+inline PoolResource::PoolResource(size_t chunk_size, std::pmr::memory_resource* upstream) noexcept
+    : upstream_(upstream)
+    , chunk_size_(chunk_size < MIN_CHUNK_SIZE ? MIN_CHUNK_SIZE : chunk_size)
+{
+}
+
+inline PoolResource::~PoolResource()
+{
+    Release();
+}
+
+inline void* PoolResource::Allocate(size_t bytes, size_t alignment)
+{
+    if (bytes > MAX_CLASS || alignment > MIN_CLASS)
+    {
+        return AllocateLarge(bytes, alignment);
+    }
+    const size_t index = ClassIndex(bytes);
+    if (free_lists_[index] == nullptr)
+    {
+        Refill(index);
+    }
+    FreeCell* cell = free_lists_[index];
+    free_lists_[index] = cell->next;
+    return cell;
+}
+
+inline void PoolResource::Deallocate(void* ptr, size_t bytes, size_t alignment) noexcept
+{
+    if (bytes > MAX_CLASS || alignment > MIN_CLASS)
+    {
+        DeallocateLarge(ptr, bytes, alignment);
+        return;
+    }
+    const size_t index = ClassIndex(bytes);
+    auto* cell = static_cast<FreeCell*>(ptr);
+    cell->next = free_lists_[index];
+    free_lists_[index] = cell;
+}
+
+inline bool PoolResource::TryExpand(void* /*ptr*/, size_t old_bytes, size_t new_bytes, size_t alignment) noexcept
+{
+    if (new_bytes > MAX_CLASS || alignment > MIN_CLASS)
+    {
+        return false;
+    }
+    return ClassIndex(old_bytes) == ClassIndex(new_bytes);
+}
+
+inline void PoolResource::Release() noexcept
+{
+    while (large_blocks_ != nullptr)
+    {
+        LargeBlock* block = large_blocks_;
+        char* data = reinterpret_cast<char*>(block) + LargeHeaderSize(block->alignment);
+        DeallocateLarge(data, block->bytes, block->alignment);
+    }
+    while (chunks_ != nullptr)
+    {
+        Chunk* next = chunks_->next;
+        upstream_->deallocate(chunks_, chunk_size_, CHUNK_ALIGNMENT);
+        chunks_ = next;
+    }
+    std::fill(std::begin(free_lists_), std::end(free_lists_), nullptr);
+    current_ = end_ = nullptr;
+}
+
+inline size_t PoolResource::ClassIndex(size_t bytes) noexcept
+{
+    size_t index = 0;
+    for (size_t size = MIN_CLASS; size < bytes; size *= 2)
+    {
+        ++index;
+    }
+    return index;
+}
+
+inline size_t PoolResource::LargeHeaderSize(size_t alignment) noexcept
+{
+    const size_t align = alignment < alignof(LargeBlock) ? alignof(LargeBlock) : alignment;
+    return (sizeof(LargeBlock) + align - 1) / align * align;
+}
+
+inline void* PoolResource::AllocateLarge(size_t bytes, size_t alignment)
+{
+    const size_t header = LargeHeaderSize(alignment);
+    const size_t align = alignment < alignof(LargeBlock) ? alignof(LargeBlock) : alignment;
+    char* raw = static_cast<char*>(upstream_->allocate(header + bytes, align));
+    auto* block = reinterpret_cast<LargeBlock*>(raw);
+    block->prev = nullptr;
+    block->next = large_blocks_;
+    block->bytes = bytes;
+    block->alignment = alignment;
+    if (large_blocks_ != nullptr)
+    {
+        large_blocks_->prev = block;
+    }
+    large_blocks_ = block;
+    return raw + header;
+}
+
+inline void PoolResource::DeallocateLarge(void* ptr, size_t bytes, size_t alignment) noexcept
+{
+    const size_t header = LargeHeaderSize(alignment);
+    const size_t align = alignment < alignof(LargeBlock) ? alignof(LargeBlock) : alignment;
+    char* raw = static_cast<char*>(ptr) - header;
+    auto* block = reinterpret_cast<LargeBlock*>(raw);
+    if (block->prev != nullptr)
+    {
+        block->prev->next = block->next;
+    }
+    else
+    {
+        large_blocks_ = block->next;
+    }
+    if (block->next != nullptr)
+    {
+        block->next->prev = block->prev;
+    }
+    upstream_->deallocate(raw, header + bytes, align);
+}
+
+inline void PoolResource::Refill(size_t index)
+{
+    const size_t cell_size = MIN_CLASS << index;
+    if (current_ == nullptr || static_cast<size_t>(end_ - current_) < cell_size)
+    {
+        //      ,    
+        for (size_t i = index; i-- > 0;)
+        {
+            const size_t size = MIN_CLASS << i;
+            while (current_ != nullptr && static_cast<size_t>(end_ - current_) >= size)
+            {
+                auto* cell = reinterpret_cast<FreeCell*>(current_);
+                cell->next = free_lists_[i];
+                free_lists_[i] = cell;
+                current_ += size;
+            }
+        }
+        auto* chunk = static_cast<Chunk*>(upstream_->allocate(chunk_size_, CHUNK_ALIGNMENT));
+        chunk->next = chunks_;
+        chunks_ = chunk;
+        current_ = reinterpret_cast<char*>(chunk) + CHUNK_HEADER_SIZE;
+        end_ = reinterpret_cast<char*>(chunk) + chunk_size_;
+    }
+    //    ,       
+    for (size_t i = 0; i < 8 && static_cast<size_t>(end_ - current_) >= cell_size; ++i)
+    {
+        auto* cell = reinterpret_cast<FreeCell*>(current_);
+        cell->next = free_lists_[index];
+        free_lists_[index] = cell;
+        current_ += cell_size;
+    }
+}
+
+inline void* PoolResource::do_allocate(size_t bytes, size_t alignment)
+{
+    return Allocate(bytes, alignment);
+}
+
+inline void PoolResource::do_deallocate(void* ptr, size_t bytes, size_t alignment)
+{
+    Deallocate(ptr, bytes, alignment);
+}
+
+inline bool PoolResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
@@ -0,0 +1,1048 @@
+﻿#include "vector.h"
+#include "concurrent_vector.h"
+#include "flat_map.h"
+#include "parallel_algorithms.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(ADVANCED_VECTOR_BENCH_STD_PAR)
+#include <execution>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Сравнение Vector и std::vector по времени, тактам, числу выделений памяти и пиковому объёму.
+// Результаты выводятся в формате CSV (по умолчанию) или JSON Lines для отслеживания регрессий.
+// Столбец checks показывает режим проверок сборки (off, hardened, checked, см. checks.h):
+// цена проверок измеряется сравнением прогонов сборок с -DADVANCED_VECTOR_HARDENED и без него.
+// Параметры командной строки:
+//     --format=csv|json
+//     --max-size=N        наибольший размер (по умолчанию 1000000, для полного прогона 100000000)
+//     --max-quadratic=N   наибольший размер для квадратичных вставок и удалений (по умолчанию 10000)
+//     --scenario=NAME     запустить только сценарий NAME
+//     --type=NAME         запустить только тип элементов NAME (int, string, pod64, obj)
+//     --container=NAME    запустить только контейнер NAME (Vector, std::vector,
+//                         ConcurrentVector, Vector+mutex, FlatMap, std::map)
+//     --max-threads=N     наибольшее число потоков в сценарии concurrent_push_back (по умолчанию 64)
+// Сценарии build и find сравнивают FlatMap и std::map с ключами uint64_t: построение из
+// перемешанных ключей и поиск случайных ключей, половина из которых отсутствует.
+// Сценарии sort, transform, reduce, for_each и partition измеряют масштабирование
+// параллельных алгоритмов из parallel_algorithms.h (контейнер Parallel) по числу потоков
+// в сравнении с последовательными (serial). С -DADVANCED_VECTOR_BENCH_STD_PAR добавляется
+// std::execution::par; для libstdc++ нужна сборка с -ltbb
+
+namespace {
+
+    // Счётчики глобального operator new. Размер блока хранится в заголовке перед ним,
+    // поэтому учитываются и освобождения
+    struct AllocationStats {
+        std::atomic<uint64_t> allocations{ 0 };
+        std::atomic<uint64_t> bytes{ 0 };
+        std::atomic<int64_t> live_bytes{ 0 };
+        std::atomic<int64_t> peak_bytes{ 0 };
+    };
+
+    AllocationStats& Stats() {
+        static AllocationStats stats;
+        return stats;
+    }
+
+    // В заголовке хранятся размер блока и размер самого заголовка
+    constexpr size_t HEADER_SIZE = alignof(std::max_align_t) > 2 * sizeof(size_t) ? alignof(std::max_align_t) : 2 * sizeof(size_t);
+
+    void RecordAllocation(size_t size) noexcept {
+        auto& stats = Stats();
+        stats.allocations.fetch_add(1, std::memory_order_relaxed);
+        stats.bytes.fetch_add(size, std::memory_order_relaxed);
+        const int64_t live = stats.live_bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed)
+            + static_cast<int64_t>(size);
+        int64_t peak = stats.peak_bytes.load(std::memory_order_relaxed);
+        while (live > peak && !stats.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    void RecordDeallocation(size_t size) noexcept {
+        Stats().live_bytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+    }
+
+    void* CountedAllocate(size_t size, size_t alignment) {
+        const size_t header = alignment > HEADER_SIZE ? alignment : HEADER_SIZE;
+        void* raw = nullptr;
+        if (alignment > alignof(std::max_align_t)) {
+            const size_t total = (header + size + alignment - 1) / alignment * alignment;
+#if defined(_MSC_VER)
+            raw = _aligned_malloc(total, alignment);
+#else
+            raw = std::aligned_alloc(alignment, total);
+#endif
+        }
+        else {
+            raw = std::malloc(header + size);
+        }
+        if (raw == nullptr) {
+            throw std::bad_alloc();
+        }
+        char* ptr = static_cast<char*>(raw) + header;
+        reinterpret_cast<size_t*>(ptr)[-1] = size;
+        reinterpret_cast<size_t*>(ptr)[-2] = header;
+        RecordAllocation(size);
+        return ptr;
+    }
+
+    void CountedDeallocate(void* ptr, size_t alignment) noexcept {
+        if (ptr == nullptr) {
+            return;
+        }
+        const size_t size = static_cast<size_t*>(ptr)[-1];
+        const size_t header = static_cast<size_t*>(ptr)[-2];
+        RecordDeallocation(size);
+        void* raw = static_cast<char*>(ptr) - header;
+#if defined(_MSC_VER)
+        if (alignment > alignof(std::max_align_t)) {
+            _aligned_free(raw);
+            return;
+        }
+#else
+        (void)alignment;
+#endif
+        std::free(raw);
+    }
+
+}  // namespace
+
+void* operator new(size_t size) {
+    return CountedAllocate(size, alignof(std::max_align_t));
+}
+void* operator new[](size_t size) {
+    return CountedAllocate(size, alignof(std::max_align_t));
+}
+void* operator new(size_t size, std::align_val_t alignment) {
+    return CountedAllocate(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return CountedAllocate(size, static_cast<size_t>(alignment));
+}
+// Варианты nothrow (их использует, например, временный буфер std::inplace_merge) проходят через
+// тот же учитываемый заголовок, иначе память освобождалась бы не той функцией
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return CountedAllocate(size, alignof(std::max_align_t));
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return CountedAllocate(size, alignof(std::max_align_t));
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return CountedAllocate(size, static_cast<size_t>(alignment));
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return CountedAllocate(size, static_cast<size_t>(alignment));
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+void operator delete(void* ptr) noexcept {
+    CountedDeallocate(ptr, alignof(std::max_align_t));
+}
+void operator delete[](void* ptr) noexcept {
+    CountedDeallocate(ptr, alignof(std::max_align_t));
+}
+void operator delete(void* ptr, size_t) noexcept {
+    CountedDeallocate(ptr, alignof(std::max_align_t));
+}
+void operator delete[](void* ptr, size_t) noexcept {
+    CountedDeallocate(ptr, alignof(std::max_align_t));
+}
+void operator delete(void* ptr, std::align_val_t alignment) noexcept {
+    CountedDeallocate(ptr, static_cast<size_t>(alignment));
+}
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept {
+    CountedDeallocate(ptr, static_cast<size_t>(alignment));
+}
+void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept {
+    CountedDeallocate(ptr, static_cast<size_t>(alignment));
+}
+void operator delete[](void* ptr, size_t, std::align_val_t alignment) noexcept {
+    CountedDeallocate(ptr, static_cast<size_t>(alignment));
+}
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    CountedDeallocate(ptr, alignof(std::max_align_t));
+}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    CountedDeallocate(ptr, alignof(std::max_align_t));
+}
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    CountedDeallocate(ptr, static_cast<size_t>(alignment));
+}
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    CountedDeallocate(ptr, static_cast<size_t>(alignment));
+}
+
+namespace {
+
+    uint64_t ReadCycles() noexcept {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    // Первый байт представления объекта: дешёвое чтение элемента, которое компилятор не может выбросить
+    template <typename T>
+    unsigned FirstByte(const T& value) noexcept {
+        return *reinterpret_cast<const unsigned char*>(&value);
+    }
+
+    constexpr std::string_view CHECKS_MODE = CHECKED_ITERATORS ? "checked" : HARDENED_CHECKS ? "hardened" : "off";
+
+    // Не даёт компилятору выбросить вычисление value
+    template <typename T>
+    void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    struct Pod64 {
+        double values[8];
+    };
+
+    // Аналог Obj из тестов: копирование может выбросить исключение, перемещение — нет
+    struct ThrowingCopy {
+        ThrowingCopy() = default;
+        explicit ThrowingCopy(int id)
+            : id(id) {
+        }
+        ThrowingCopy(const ThrowingCopy& other)
+            : id(other.id)
+            , name(other.name) {
+            if (other.throw_on_copy) {
+                throw std::runtime_error("Oops");
+            }
+        }
+        ThrowingCopy(ThrowingCopy&& other) noexcept = default;
+        ThrowingCopy& operator=(const ThrowingCopy& other) = default;
+        ThrowingCopy& operator=(ThrowingCopy&& other) noexcept = default;
+
+        bool throw_on_copy = false;
+        int id = 0;
+        std::string name;
+    };
+
+    template <typename T>
+    T MakeValue(size_t i);
+
+    template <>
+    int MakeValue<int>(size_t i) {
+        return static_cast<int>(i);
+    }
+
+    template <>
+    std::string MakeValue<std::string>(size_t i) {
+        // Достаточно длинная строка, чтобы не помещаться во встроенный буфер
+        return "benchmark-string-value-" + std::to_string(i);
+    }
+
+    template <>
+    Pod64 MakeValue<Pod64>(size_t i) {
+        Pod64 pod{};
+        pod.values[0] = static_cast<double>(i);
+        return pod;
+    }
+
+    template <>
+    ThrowingCopy MakeValue<ThrowingCopy>(size_t i) {
+        return ThrowingCopy(static_cast<int>(i));
+    }
+
+    template <typename T>
+    struct VectorOps {
+        using Container = Vector<T>;
+        static constexpr std::string_view NAME = "Vector";
+
+        static void PushBack(Container& c, const T& value) {
+            c.PushBack(value);
+        }
+        static void EmplaceBack(Container& c, size_t i) {
+            c.EmplaceBack(MakeValue<T>(i));
+        }
+        static void Insert(Container& c, size_t pos, const T& value) {
+            c.Insert(c.cbegin() + pos, value);
+        }
+        static void Emplace(Container& c, size_t pos, size_t i) {
+            c.Emplace(c.cbegin() + pos, MakeValue<T>(i));
+        }
+        static void Erase(Container& c, size_t pos) {
+            c.Erase(c.cbegin() + pos);
+        }
+        static void Reserve(Container& c, size_t n) {
+            c.Reserve(n);
+        }
+        static void Resize(Container& c, size_t n) {
+            c.Resize(n);
+        }
+        static size_t Size(const Container& c) {
+            return c.Size();
+        }
+        static const T* Data(const Container& c) {
+            return c.Data();
+        }
+    };
+
+    template <typename T>
+    struct StdVectorOps {
+        using Container = std::vector<T>;
+        static constexpr std::string_view NAME = "std::vector";
+
+        static void PushBack(Container& c, const T& value) {
+            c.push_back(value);
+        }
+        static void EmplaceBack(Container& c, size_t i) {
+            c.emplace_back(MakeValue<T>(i));
+        }
+        static void Insert(Container& c, size_t pos, const T& value) {
+            c.insert(c.begin() + static_cast<std::ptrdiff_t>(pos), value);
+        }
+        static void Emplace(Container& c, size_t pos, size_t i) {
+            c.emplace(c.begin() + static_cast<std::ptrdiff_t>(pos), MakeValue<T>(i));
+        }
+        static void Erase(Container& c, size_t pos) {
+            c.erase(c.begin() + static_cast<std::ptrdiff_t>(pos));
+        }
+        static void Reserve(Container& c, size_t n) {
+            c.reserve(n);
+        }
+        static void Resize(Container& c, size_t n) {
+            c.resize(n);
+        }
+        static size_t Size(const Container& c) {
+            return c.size();
+        }
+        static const T* Data(const Container& c) {
+            return c.data();
+        }
+    };
+
+    struct Options {
+        std::string format = "csv";
+        size_t max_size = 1'000'000;
+        size_t max_quadratic = 10'000;
+        std::string scenario;
+        std::string type;
+        std::string container;
+        size_t max_threads = 64;
+    };
+
+    struct Measurement {
+        std::string_view container;
+        std::string_view scenario;
+        std::string_view type;
+        size_t size = 0;
+        size_t threads = 1;
+        size_t repetitions = 0;
+        double ns_total = 0;
+        double cycles_total = 0;
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        int64_t peak_bytes = 0;
+    };
+
+    // Измеряет только код внутри Measure, подготовка и уничтожение контейнеров не учитываются
+    class Probe {
+    public:
+        template <typename Func>
+        void Measure(Func func) {
+            auto& stats = Stats();
+            const uint64_t allocations = stats.allocations.load();
+            const uint64_t bytes = stats.bytes.load();
+            const int64_t live = stats.live_bytes.load();
+            stats.peak_bytes.store(live);
+            const auto start = std::chrono::steady_clock::now();
+            const uint64_t start_cycles = ReadCycles();
+            func();
+            const uint64_t end_cycles = ReadCycles();
+            const auto end = std::chrono::steady_clock::now();
+            ns_ += std::chrono::duration<double, std::nano>(end - start).count();
+            cycles_ += static_cast<double>(end_cycles - start_cycles);
+            allocations_ += stats.allocations.load() - allocations;
+            bytes_ += stats.bytes.load() - bytes;
+            peak_bytes_ = std::max(peak_bytes_, stats.peak_bytes.load() - live);
+        }
+
+        void Fill(Measurement& m) const {
+            m.ns_total = ns_;
+            m.cycles_total = cycles_;
+            m.allocations = allocations_;
+            m.bytes = bytes_;
+            m.peak_bytes = peak_bytes_;
+        }
+
+    private:
+        double ns_ = 0;
+        double cycles_ = 0;
+        uint64_t allocations_ = 0;
+        uint64_t bytes_ = 0;
+        int64_t peak_bytes_ = 0;
+    };
+
+    enum class Position {
+        FRONT,
+        MIDDLE,
+        BACK,
+    };
+
+    size_t PositionIndex(Position position, size_t size) {
+        switch (position) {
+        case Position::FRONT:
+            return 0;
+        case Position::MIDDLE:
+            return size / 2;
+        case Position::BACK:
+            return size;
+        }
+        return size;
+    }
+
+    template <typename Ops, typename T>
+    typename Ops::Container MakeFilled(size_t n) {
+        typename Ops::Container c;
+        Ops::Reserve(c, n);
+        for (size_t i = 0; i < n; ++i) {
+            Ops::PushBack(c, MakeValue<T>(i));
+        }
+        return c;
+    }
+
+    template <typename Ops, typename T>
+    void RunScenario(std::string_view scenario, size_t n, size_t repetitions, Probe& probe) {
+        using Container = typename Ops::Container;
+        const T value = MakeValue<T>(n);
+        for (size_t rep = 0; rep < repetitions; ++rep) {
+            if (scenario == "push_back") {
+                Container c;
+                probe.Measure([&] {
+                    for (size_t i = 0; i < n; ++i) {
+                        Ops::PushBack(c, value);
+                    }
+                    });
+                DoNotOptimize(Ops::Data(c));
+            }
+            else if (scenario == "emplace_back") {
+                Container c;
+                probe.Measure([&] {
+                    for (size_t i = 0; i < n; ++i) {
+                        Ops::EmplaceBack(c, i);
+                    }
+                    });
+                DoNotOptimize(Ops::Data(c));
+            }
+            else if (scenario.substr(0, 7) == "insert_" || scenario.substr(0, 8) == "emplace_") {
+                const bool emplace = scenario.substr(0, 8) == "emplace_";
+                const std::string_view where = scenario.substr(emplace ? 8 : 7);
+                const Position position = where == "front" ? Position::FRONT
+                    : where == "middle" ? Position::MIDDLE : Position::BACK;
+                Container c;
+                probe.Measure([&] {
+                    for (size_t i = 0; i < n; ++i) {
+                        const size_t pos = PositionIndex(position, Ops::Size(c));
+                        if (emplace) {
+                            Ops::Emplace(c, pos, i);
+                        }
+                        else {
+                            Ops::Insert(c, pos, value);
+                        }
+                    }
+                    });
+                DoNotOptimize(Ops::Data(c));
+            }
+            else if (scenario.substr(0, 6) == "erase_") {
+                const std::string_view where = scenario.substr(6);
+                const Position position = where == "front" ? Position::FRONT
+                    : where == "middle" ? Position::MIDDLE : Position::BACK;
+                Container c = MakeFilled<Ops, T>(n);
+                probe.Measure([&] {
+                    for (size_t i = 0; i < n; ++i) {
+                        const size_t size = Ops::Size(c);
+                        const size_t pos = position == Position::BACK ? size - 1 : PositionIndex(position, size);
+                        Ops::Erase(c, pos);
+                    }
+                    });
+                DoNotOptimize(Ops::Data(c));
+            }
+            else if (scenario == "iterate") {
+                const Container c = MakeFilled<Ops, T>(n);
+                probe.Measure([&] {
+                    unsigned checksum = 0;
+                    for (const T& elem : c) {
+                        checksum += FirstByte(elem);
+                    }
+                    DoNotOptimize(checksum);
+                    });
+            }
+            else if (scenario == "index") {
+                const Container c = MakeFilled<Ops, T>(n);
+                probe.Measure([&] {
+                    unsigned checksum = 0;
+                    for (size_t i = 0; i < n; ++i) {
+                        checksum += FirstByte(c[i]);
+                    }
+                    DoNotOptimize(checksum);
+                    });
+            }
+            else if (scenario == "copy_assign") {
+                const Container source = MakeFilled<Ops, T>(n);
+                Container target = MakeFilled<Ops, T>(n);
+                probe.Measure([&] {
+                    target = source;
+                    });
+                DoNotOptimize(Ops::Data(target));
+            }
+            else if (scenario == "reserve") {
+                Container c = MakeFilled<Ops, T>(n);
+                probe.Measure([&] {
+                    Ops::Reserve(c, n * 2);
+                    });
+                DoNotOptimize(Ops::Data(c));
+            }
+            else if (scenario == "resize") {
+                Container c;
+                probe.Measure([&] {
+                    Ops::Resize(c, n);
+                    });
+                DoNotOptimize(Ops::Data(c));
+            }
+        }
+    }
+
+    bool IsQuadratic(std::string_view scenario) {
+        return (scenario.find("front") != std::string_view::npos || scenario.find("middle") != std::string_view::npos);
+    }
+
+    void Print(const Measurement& m, const Options& options, std::ostream& out) {
+        const double per_element = m.size == 0 ? 0 : 1.0 / static_cast<double>(m.size * m.repetitions);
+        const double per_rep = 1.0 / static_cast<double>(m.repetitions);
+        if (options.format == "json") {
+            out << "{\"container\":\"" << m.container << "\",\"scenario\":\"" << m.scenario
+                << "\",\"type\":\"" << m.type << "\",\"size\":" << m.size
+                << ",\"threads\":" << m.threads
+                << ",\"checks\":\"" << CHECKS_MODE << '"'
+                << ",\"repetitions\":" << m.repetitions
+                << ",\"ns_per_rep\":" << m.ns_total * per_rep
+                << ",\"ns_per_element\":" << m.ns_total * per_element
+                << ",\"cycles_per_element\":" << m.cycles_total * per_element
+                << ",\"allocations_per_rep\":" << static_cast<double>(m.allocations) * per_rep
+                << ",\"bytes_per_rep\":" << static_cast<double>(m.bytes) * per_rep
+                << ",\"peak_bytes\":" << m.peak_bytes << "}\n";
+        }
+        else {
+            out << m.container << ',' << m.scenario << ',' << m.type << ',' << m.size << ',' << m.threads << ','
+                << CHECKS_MODE << ','
+                << m.repetitions << ','
+                << m.ns_total * per_rep << ',' << m.ns_total * per_element << ',' << m.cycles_total * per_element << ','
+                << static_cast<double>(m.allocations) * per_rep << ',' << static_cast<double>(m.bytes) * per_rep << ','
+                << m.peak_bytes << '\n';
+        }
+    }
+
+    template <typename Ops, typename T>
+    void RunContainer(std::string_view type, const Options& options) {
+        static constexpr std::string_view SCENARIOS[] = {
+            "push_back", "emplace_back",
+            "insert_front", "insert_middle", "insert_back",
+            "emplace_front", "emplace_middle",
+            "erase_front", "erase_middle", "erase_back",
+            "iterate", "index",
+            "copy_assign", "reserve", "resize",
+        };
+        if (!options.container.empty() && options.container != Ops::NAME) {
+            return;
+        }
+        for (std::string_view scenario : SCENARIOS) {
+            if (!options.scenario.empty() && options.scenario != scenario) {
+                continue;
+            }
+            const size_t max_size = IsQuadratic(scenario) ? std::min(options.max_size, options.max_quadratic) : options.max_size;
+            for (size_t n = 1; n <= max_size; n *= 10) {
+                // Число повторов подбирается так, чтобы каждая точка обрабатывала порядка 10^6 элементов
+                const size_t work = IsQuadratic(scenario) ? n * n : n;
+                const size_t repetitions = std::max<size_t>(1, 1'000'000 / std::max<size_t>(1, work));
+                Probe probe;
+                RunScenario<Ops, T>(scenario, n, repetitions, probe);
+                Measurement m;
+                m.container = Ops::NAME;
+                m.scenario = scenario;
+                m.type = type;
+                m.size = n;
+                m.repetitions = repetitions;
+                probe.Fill(m);
+                Print(m, options, std::cout);
+                std::cout.flush();
+            }
+        }
+    }
+
+    template <typename T>
+    struct ConcurrentVectorOps {
+        using Container = ConcurrentVector<T>;
+        static constexpr std::string_view NAME = "ConcurrentVector";
+
+        static void PushBack(Container& c, const T& value) {
+            c.PushBack(value);
+        }
+        static size_t Size(const Container& c) {
+            return c.Size();
+        }
+    };
+
+    // Прежний способ добавления из нескольких потоков: Vector под общим мьютексом
+    template <typename T>
+    struct LockedVectorOps {
+        struct Container {
+            std::mutex mutex;
+            Vector<T> vector;
+        };
+        static constexpr std::string_view NAME = "Vector+mutex";
+
+        static void PushBack(Container& c, const T& value) {
+            std::lock_guard guard(c.mutex);
+            c.vector.PushBack(value);
+        }
+        static size_t Size(const Container& c) {
+            return c.vector.Size();
+        }
+    };
+
+    template <typename T>
+    struct FlatMapOps {
+        using Container = FlatMap<uint64_t, T>;
+        static constexpr std::string_view NAME = "FlatMap";
+
+        static void Build(Container& c, const std::vector<std::pair<uint64_t, T>>& items) {
+            c.InsertBatch(items.begin(), items.end());
+        }
+        static const T* Find(const Container& c, uint64_t key) {
+            const auto it = c.Find(key);
+            return it == c.end() ? nullptr : &it->second;
+        }
+        static size_t Size(const Container& c) {
+            return c.Size();
+        }
+    };
+
+    template <typename T>
+    struct StdMapOps {
+        using Container = std::map<uint64_t, T>;
+        static constexpr std::string_view NAME = "std::map";
+
+        static void Build(Container& c, const std::vector<std::pair<uint64_t, T>>& items) {
+            c.insert(items.begin(), items.end());
+        }
+        static const T* Find(const Container& c, uint64_t key) {
+            const auto it = c.find(key);
+            return it == c.end() ? nullptr : &it->second;
+        }
+        static size_t Size(const Container& c) {
+            return c.size();
+        }
+    };
+
+    // Нечётные ключи 1, 3, ..., 2n - 1 в случайном порядке
+    template <typename T>
+    std::vector<std::pair<uint64_t, T>> MakeLookupItems(size_t n) {
+        std::vector<std::pair<uint64_t, T>> items;
+        items.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            items.emplace_back(2 * i + 1, MakeValue<T>(i));
+        }
+        std::shuffle(items.begin(), items.end(), std::mt19937_64(n));
+        return items;
+    }
+
+    template <typename Ops, typename T>
+    void RunLookupScenario(std::string_view scenario, size_t n, size_t repetitions, Probe& probe) {
+        const auto items = MakeLookupItems<T>(n);
+        std::vector<uint64_t> queries(n);
+        std::mt19937_64 rng(n + 1);
+        for (uint64_t& key : queries) {
+            key = rng() % (2 * n);
+        }
+        for (size_t rep = 0; rep < repetitions; ++rep) {
+            typename Ops::Container c;
+            if (scenario == "build") {
+                probe.Measure([&] {
+                    Ops::Build(c, items);
+                    });
+                DoNotOptimize(Ops::Size(c));
+            }
+            else if (scenario == "find") {
+                Ops::Build(c, items);
+                probe.Measure([&] {
+                    size_t found = 0;
+                    for (uint64_t key : queries) {
+                        found += Ops::Find(c, key) != nullptr ? 1 : 0;
+                    }
+                    DoNotOptimize(found);
+                    });
+            }
+        }
+    }
+
+    template <typename Ops, typename T>
+    void RunLookupContainer(std::string_view type, const Options& options) {
+        static constexpr std::string_view SCENARIOS[] = { "build", "find" };
+        if (!options.container.empty() && options.container != Ops::NAME) {
+            return;
+        }
+        for (std::string_view scenario : SCENARIOS) {
+            if (!options.scenario.empty() && options.scenario != scenario) {
+                continue;
+            }
+            for (size_t n = 1; n <= options.max_size; n *= 10) {
+                const size_t repetitions = std::max<size_t>(1, 1'000'000 / n);
+                Probe probe;
+                RunLookupScenario<Ops, T>(scenario, n, repetitions, probe);
+                Measurement m;
+                m.container = Ops::NAME;
+                m.scenario = scenario;
+                m.type = type;
+                m.size = n;
+                m.repetitions = repetitions;
+                probe.Fill(m);
+                Print(m, options, std::cout);
+                std::cout.flush();
+            }
+        }
+    }
+
+    // Последовательные версии алгоритмов: точка отсчёта для масштабирования
+    struct SerialAlgorithms {
+        static constexpr std::string_view NAME = "serial";
+        static constexpr bool SCALES = false;
+
+        template <typename T, typename Compare>
+        static void Sort(Vector<T>& v, Compare comp) {
+            std::sort(v.begin(), v.end(), comp);
+        }
+        template <typename T, typename Op>
+        static void Transform(const Vector<T>& in, Vector<T>& out, Op op) {
+            std::transform(in.begin(), in.end(), out.begin(), op);
+        }
+        template <typename T, typename U>
+        static U Reduce(const Vector<T>& v, U init) {
+            return std::accumulate(v.begin(), v.end(), init);
+        }
+        template <typename T, typename Fn>
+        static void ForEach(Vector<T>& v, Fn fn) {
+            std::for_each(v.begin(), v.end(), fn);
+        }
+        template <typename T, typename Predicate>
+        static size_t Partition(Vector<T>& v, Predicate pred) {
+            return static_cast<size_t>(std::partition(v.begin(), v.end(), pred) - v.begin());
+        }
+    };
+
+    struct ParallelAlgorithms {
+        static constexpr std::string_view NAME = "Parallel";
+        static constexpr bool SCALES = true;
+
+        template <typename T, typename Compare>
+        static void Sort(Vector<T>& v, Compare comp) {
+            ParallelSort(v, comp);
+        }
+        template <typename T, typename Op>
+        static void Transform(const Vector<T>& in, Vector<T>& out, Op op) {
+            ParallelTransform(in, out, op);
+        }
+        template <typename T, typename U>
+        static U Reduce(const Vector<T>& v, U init) {
+            return ParallelReduce(v, init);
+        }
+        template <typename T, typename Fn>
+        static void ForEach(Vector<T>& v, Fn fn) {
+            ParallelForEach(v, fn);
+        }
+        template <typename T, typename Predicate>
+        static size_t Partition(Vector<T>& v, Predicate pred) {
+            return static_cast<size_t>(ParallelPartition(v, pred) - v.begin());
+        }
+    };
+
+#if defined(ADVANCED_VECTOR_BENCH_STD_PAR)
+    // Число потоков std::execution::par задаёт реализация, поэтому замер выполняется один раз
+    struct StdParAlgorithms {
+        static constexpr std::string_view NAME = "std::execution::par";
+        static constexpr bool SCALES = false;
+
+        template <typename T, typename Compare>
+        static void Sort(Vector<T>& v, Compare comp) {
+            std::sort(std::execution::par, v.Data(), v.Data() + v.Size(), comp);
+        }
+        template <typename T, typename Op>
+        static void Transform(const Vector<T>& in, Vector<T>& out, Op op) {
+            std::transform(std::execution::par, in.Data(), in.Data() + in.Size(), out.Data(), op);
+        }
+        template <typename T, typename U>
+        static U Reduce(const Vector<T>& v, U init) {
+            return std::reduce(std::execution::par, v.Data(), v.Data() + v.Size(), init);
+        }
+        template <typename T, typename Fn>
+        static void ForEach(Vector<T>& v, Fn fn) {
+            std::for_each(std::execution::par, v.Data(), v.Data() + v.Size(), fn);
+        }
+        template <typename T, typename Predicate>
+        static size_t Partition(Vector<T>& v, Predicate pred) {
+            return static_cast<size_t>(std::partition(std::execution::par, v.Data(), v.Data() + v.Size(), pred) - v.Data());
+        }
+    };
+#endif
+
+    template <typename Algorithms, typename T>
+    void RunAlgorithmScenario(std::string_view scenario, const Vector<T>& input, size_t repetitions, Probe& probe) {
+        const auto combine = [](T x) {
+            return static_cast<T>(x * 3 + 1);
+        };
+        const auto is_even = [](T x) {
+            return x % 2 == 0;
+        };
+        for (size_t rep = 0; rep < repetitions; ++rep) {
+            Vector<T> v = input;
+            if (scenario == "sort") {
+                probe.Measure([&] {
+                    Algorithms::Sort(v, std::less<>());
+                    });
+            }
+            else if (scenario == "transform") {
+                probe.Measure([&] {
+                    Algorithms::Transform(input, v, combine);
+                    });
+            }
+            else if (scenario == "reduce") {
+                probe.Measure([&] {
+                    DoNotOptimize(Algorithms::Reduce(input, int64_t(0)));
+                    });
+            }
+            else if (scenario == "for_each") {
+                probe.Measure([&] {
+                    Algorithms::ForEach(v, [&combine](T& x) {
+                        x = combine(x);
+                    });
+                    });
+            }
+            else if (scenario == "partition") {
+                probe.Measure([&] {
+                    DoNotOptimize(Algorithms::Partition(v, is_even));
+                    });
+            }
+            DoNotOptimize(v.Data());
+        }
+    }
+
+    // Алгоритмы над n = max_size элементами. Для Parallel число потоков ограничивается
+    // SetParallelThreadLimit и удваивается от 1 до max_threads
+    template <typename Algorithms, typename T>
+    void RunAlgorithms(std::string_view type, const Options& options) {
+        static constexpr std::string_view SCENARIOS[] = { "sort", "transform", "reduce", "for_each", "partition" };
+        if (!options.container.empty() && options.container != Algorithms::NAME) {
+            return;
+        }
+        const size_t n = options.max_size;
+        Vector<T> input(n);
+        std::mt19937 rng(static_cast<uint32_t>(n));
+        for (T& x : input) {
+            x = static_cast<T>(rng() % 1'000'000);
+        }
+        const size_t repetitions = std::max<size_t>(1, 10'000'000 / std::max<size_t>(1, n));
+        const size_t max_threads = Algorithms::SCALES ? options.max_threads : 1;
+        for (std::string_view scenario : SCENARIOS) {
+            if (!options.scenario.empty() && options.scenario != scenario) {
+                continue;
+            }
+            for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+                SetParallelThreadLimit(static_cast<unsigned>(threads));
+                Probe probe;
+                RunAlgorithmScenario<Algorithms, T>(scenario, input, repetitions, probe);
+                Measurement m;
+                m.container = Algorithms::NAME;
+                m.scenario = scenario;
+                m.type = type;
+                m.size = n;
+                m.threads = Algorithms::SCALES ? threads : std::max(std::thread::hardware_concurrency(), 1u);
+                m.repetitions = repetitions;
+                probe.Fill(m);
+                Print(m, options, std::cout);
+                std::cout.flush();
+            }
+            SetParallelThreadLimit(0);
+        }
+    }
+
+    // Потоки одновременно добавляют в один контейнер n элементов поровну. Потоки запускаются
+    // до начала измерения и ждут общего сигнала, поэтому время их создания не учитывается
+    template <typename Ops, typename T>
+    void RunConcurrentScenario(size_t n, size_t threads, size_t repetitions, Probe& probe) {
+        const T value = MakeValue<T>(n);
+        for (size_t rep = 0; rep < repetitions; ++rep) {
+            typename Ops::Container c;
+            std::atomic<bool> start{ false };
+            std::vector<std::thread> workers;
+            workers.reserve(threads);
+            for (size_t t = 0; t < threads; ++t) {
+                const size_t count = n / threads + (t < n % threads ? 1 : 0);
+                workers.emplace_back([&c, &start, &value, count] {
+                    while (!start.load(std::memory_order_acquire)) {
+                        std::this_thread::yield();
+                    }
+                    for (size_t i = 0; i < count; ++i) {
+                        Ops::PushBack(c, value);
+                    }
+                });
+            }
+            probe.Measure([&] {
+                start.store(true, std::memory_order_release);
+                for (std::thread& worker : workers) {
+                    worker.join();
+                }
+                });
+            DoNotOptimize(Ops::Size(c));
+        }
+    }
+
+    template <typename Ops, typename T>
+    void RunConcurrentContainer(std::string_view type, const Options& options) {
+        constexpr std::string_view SCENARIO = "concurrent_push_back";
+        if ((!options.container.empty() && options.container != Ops::NAME)
+            || (!options.scenario.empty() && options.scenario != SCENARIO)) {
+            return;
+        }
+        const size_t n = options.max_size;
+        for (size_t threads = 1; threads <= options.max_threads; threads *= 2) {
+            const size_t repetitions = std::max<size_t>(1, 1'000'000 / std::max<size_t>(1, n));
+            Probe probe;
+            RunConcurrentScenario<Ops, T>(n, threads, repetitions, probe);
+            Measurement m;
+            m.container = Ops::NAME;
+            m.scenario = SCENARIO;
+            m.type = type;
+            m.size = n;
+            m.threads = threads;
+            m.repetitions = repetitions;
+            probe.Fill(m);
+            Print(m, options, std::cout);
+            std::cout.flush();
+        }
+    }
+
+    template <typename T>
+    void RunType(std::string_view type, const Options& options) {
+        if (!options.type.empty() && options.type != type) {
+            return;
+        }
+        RunContainer<VectorOps<T>, T>(type, options);
+        RunContainer<StdVectorOps<T>, T>(type, options);
+        RunConcurrentContainer<ConcurrentVectorOps<T>, T>(type, options);
+        RunConcurrentContainer<LockedVectorOps<T>, T>(type, options);
+        RunLookupContainer<FlatMapOps<T>, T>(type, options);
+        RunLookupContainer<StdMapOps<T>, T>(type, options);
+        if constexpr (std::is_arithmetic_v<T>) {
+            RunAlgorithms<SerialAlgorithms, T>(type, options);
+            RunAlgorithms<ParallelAlgorithms, T>(type, options);
+#if defined(ADVANCED_VECTOR_BENCH_STD_PAR)
+            RunAlgorithms<StdParAlgorithms, T>(type, options);
+#endif
+        }
+    }
+
+    Options ParseOptions(int argc, char* argv[]) {
+        Options options;
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            const auto value = [&arg](std::string_view prefix) {
+                return std::string(arg.substr(prefix.size()));
+            };
+            if (arg.substr(0, 9) == "--format=") {
+                options.format = value("--format=");
+            }
+            else if (arg.substr(0, 11) == "--max-size=") {
+                options.max_size = std::stoull(value("--max-size="));
+            }
+            else if (arg.substr(0, 16) == "--max-quadratic=") {
+                options.max_quadratic = std::stoull(value("--max-quadratic="));
+            }
+            else if (arg.substr(0, 11) == "--scenario=") {
+                options.scenario = value("--scenario=");
+            }
+            else if (arg.substr(0, 7) == "--type=") {
+                options.type = value("--type=");
+            }
+            else if (arg.substr(0, 12) == "--container=") {
+                options.container = value("--container=");
+            }
+            else if (arg.substr(0, 14) == "--max-threads=") {
+                options.max_threads = std::stoull(value("--max-threads="));
+            }
+            else {
+                throw std::invalid_argument("Unknown option: " + std::string(arg));
+            }
+        }
+        return options;
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        const Options options = ParseOptions(argc, argv);
+        if (options.format != "json") {
+            std::cout << "container,scenario,type,size,threads,checks,repetitions,ns_per_rep,ns_per_element,cycles_per_element,"
+                "allocations_per_rep,bytes_per_rep,peak_bytes\n";
+        }
+        RunType<int>("int", options);
+        RunType<std::string>("string", options);
+        RunType<Pod64>("pod64", options);
+        RunType<ThrowingCopy>("obj", options);
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,209 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <type_traits>
+
+//   Vector,   .
+// ADVANCED_VECTOR_HARDENED      operator[], PopBack, Insert  Erase.
+//     std::abort,      canary-.
+// ADVANCED_VECTOR_CHECKED    Vector :  
+//       ,   .
+//     ,    
+
+#if defined(ADVANCED_VECTOR_CHECKED)
+inline constexpr bool CHECKED_ITERATORS = true;
+#else
+inline constexpr bool CHECKED_ITERATORS = false;
+#endif
+
+#if defined(ADVANCED_VECTOR_HARDENED) || defined(ADVANCED_VECTOR_CHECKED)
+inline constexpr bool HARDENED_CHECKS = true;
+#else
+inline constexpr bool HARDENED_CHECKS = false;
+#endif
+
+namespace detail {
+
+    [[noreturn]] inline void CheckFailed(const char* message) noexcept {
+        std::fprintf(stderr, "advanced-vector: %s\n", message);
+        std::abort();
+    }
+
+    // ,    HARDENED  CHECKED
+    inline void HardenedCheck(bool condition, const char* message) noexcept {
+        if constexpr (HARDENED_CHECKS) {
+            if (!condition) {
+                CheckFailed(message);
+            }
+        }
+    }
+
+    //  .    ,    
+    // .  ADVANCED_VECTOR_CHECKED       
+    template <bool Enabled = CHECKED_ITERATORS>
+    class GenerationCounter {
+    public:
+        uint64_t Generation() const noexcept {
+            return 0;
+        }
+        void Invalidate() noexcept {
+        }
+    };
+
+    template <>
+    class GenerationCounter<true> {
+    public:
+        uint64_t Generation() const noexcept {
+            return generation_;
+        }
+        void Invalidate() noexcept {
+            ++generation_;
+        }
+
+    private:
+        uint64_t generation_ = 0;
+    };
+
+    //     Container   Data()  Size().
+    //         .   [begin, end),
+    //    [begin, end],      
+    //     
+    template <typename T, typename Container>
+    class CheckedIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        CheckedIterator() = default;
+        CheckedIterator(T* ptr, const Container* owner, uint64_t generation) noexcept
+            : ptr_(ptr)
+            , owner_(owner)
+            , generation_(generation) {
+        }
+        //     
+        template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+        CheckedIterator(const CheckedIterator<U, Container>& other) noexcept
+            : ptr_(other.ptr_)
+            , owner_(other.owner_)
+            , generation_(other.generation_) {
+        }
+
+        reference operator*() const noexcept {
+            CheckDereferenceable();
+            return *ptr_;
+        }
+        pointer operator->() const noexcept {
+            CheckDereferenceable();
+            return ptr_;
+        }
+        reference operator[](difference_type n) const noexcept {
+            return *(*this + n);
+        }
+
+        CheckedIterator& operator++() noexcept {
+            return *this += 1;
+        }
+        CheckedIterator operator++(int) noexcept {
+            CheckedIterator old = *this;
+            *this += 1;
+            return old;
+        }
+        CheckedIterator& operator--() noexcept {
+            return *this -= 1;
+        }
+        CheckedIterator operator--(int) noexcept {
+            CheckedIterator old = *this;
+            *this -= 1;
+            return old;
+        }
+        CheckedIterator& operator+=(difference_type n) noexcept {
+            CheckValid();
+            const difference_type offset = ptr_ - owner_->Data();
+            HardenedCheck(offset + n >= 0 && offset + n <= static_cast<difference_type>(owner_->Size()), "iterator moved out of range");
+            ptr_ += n;
+            return *this;
+        }
+        CheckedIterator& operator-=(difference_type n) noexcept {
+            return *this += -n;
+        }
+
+        friend CheckedIterator operator+(CheckedIterator it, difference_type n) noexcept {
+            return it += n;
+        }
+        friend CheckedIterator operator+(difference_type n, CheckedIterator it) noexcept {
+            return it += n;
+        }
+        friend CheckedIterator operator-(CheckedIterator it, difference_type n) noexcept {
+            return it -= n;
+        }
+        friend difference_type operator-(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+            lhs.CheckComparable(rhs);
+            return lhs.ptr_ - rhs.ptr_;
+        }
+
+        friend bool operator==(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+            lhs.CheckComparable(rhs);
+            return lhs.ptr_ == rhs.ptr_;
+        }
+        friend bool operator!=(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+        friend bool operator<(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+            lhs.CheckComparable(rhs);
+            return lhs.ptr_ < rhs.ptr_;
+        }
+        friend bool operator>(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+            return rhs < lhs;
+        }
+        friend bool operator<=(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+            return !(rhs < lhs);
+        }
+        friend bool operator>=(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+            return !(lhs < rhs);
+        }
+
+        //    
+        pointer Base() const noexcept {
+            return ptr_;
+        }
+
+        //   owner   
+        bool IsValidFor(const Container* owner) const noexcept {
+            return owner_ == owner && owner_->IteratorGeneration() == generation_;
+        }
+
+    private:
+        template <typename, typename>
+        friend class CheckedIterator;
+
+        void CheckValid() const noexcept {
+            HardenedCheck(owner_ != nullptr, "singular iterator used");
+            HardenedCheck(owner_->IteratorGeneration() == generation_, "invalidated iterator used");
+        }
+
+        void CheckDereferenceable() const noexcept {
+            CheckValid();
+            HardenedCheck(ptr_ >= owner_->Data() && ptr_ < owner_->Data() + owner_->Size(), "iterator dereferenced out of range");
+        }
+
+        void CheckComparable(const CheckedIterator& other) const noexcept {
+            if (owner_ == nullptr && other.owner_ == nullptr) {
+                return;
+            }
+            HardenedCheck(owner_ == other.owner_, "iterators of different containers compared");
+            CheckValid();
+            other.CheckValid();
+        }
+
+        T* ptr_ = nullptr;
+        const Container* owner_ = nullptr;
+        uint64_t generation_ = 0;
+    };
+
+}  // namespace detail
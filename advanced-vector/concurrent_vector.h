@@ -0,0 +1,333 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "segmented_vector.h"
+#include "vector.h"
+
+namespace detail {
+
+    constexpr size_t FloorLog2(size_t value) noexcept {
+        assert(value != 0);
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(std::numeric_limits<unsigned long long>::digits - 1 - __builtin_clzll(value));
+#else
+        size_t log = 0;
+        while (value >>= 1) {
+            ++log;
+        }
+        return log;
+#endif
+    }
+
+}  // namespace detail
+
+// ,         .
+//    ,     ,  
+//    ,     :   
+//   Clear   .
+//     ,     . Size() 
+//     :  [0, Size())    
+//     . Clear     
+//    .
+//        ,      
+//   ,      .   T 
+//    EmplaceBack       noexcept
+template <typename T, typename Allocator = std::allocator<T>>
+class ConcurrentVector {
+    //      
+    struct Slot {
+        std::atomic<bool> ready;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+    using SlotTraits = std::allocator_traits<SlotAllocator>;
+
+public:
+    using allocator_type = Allocator;
+
+    //   
+    static constexpr size_t FIRST_SEGMENT_SIZE = detail::DefaultSegmentSize<T>();
+
+    ConcurrentVector() = default;
+    explicit ConcurrentVector(const Allocator& alloc) noexcept;
+
+    //    ,      
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    Allocator GetAllocator() const noexcept;
+
+    //   
+    size_t Size() const noexcept;
+    //   
+    size_t Capacity() const noexcept;
+
+    //     new_capacity .    
+    void Reserve(size_t new_capacity);
+
+    void PushBack(const T& value);
+    void PushBack(T&& value);
+
+    //       .     Size(),
+    //       
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+
+    //    
+    Vector<T, Allocator> Flatten() const;
+
+    //  .     
+    void Clear() noexcept;
+
+    const T& operator[](size_t index) const noexcept;
+    T& operator[](size_t index) noexcept;
+
+    ~ConcurrentVector();
+
+private:
+    //  ,     size_t
+    static constexpr size_t MAX_SEGMENTS = std::numeric_limits<size_t>::digits - detail::FloorLog2(FIRST_SEGMENT_SIZE);
+
+    static size_t SegmentOf(size_t index) noexcept;
+    static size_t SegmentBegin(size_t segment) noexcept;
+    static size_t SegmentCapacity(size_t segment) noexcept;
+
+    Slot& SlotAt(size_t index) const noexcept;
+
+    //   segment,    
+    void EnsureSegment(size_t segment);
+
+    //         
+    size_t ReserveSlot();
+
+    //       
+    void Publish(size_t index) noexcept;
+
+private:
+    SlotAllocator alloc_;
+    std::atomic<Slot*> segments_[MAX_SEGMENTS] = {};
+    //   
+    std::atomic<size_t> reserved_{ 0 };
+    //   
+    std::atomic<size_t> size_{ 0 };
+};
+
+template<typename T, typename Allocator>
+inline ConcurrentVector<T, Allocator>::ConcurrentVector(const Allocator& alloc) noexcept
+    : alloc_(alloc)
+{
+}
+
+template<typename T, typename Allocator>
+inline Allocator ConcurrentVector<T, Allocator>::GetAllocator() const noexcept
+{
+    return Allocator(alloc_);
+}
+
+template<typename T, typename Allocator>
+inline size_t ConcurrentVector<T, Allocator>::Size() const noexcept
+{
+    return size_.load(std::memory_order_acquire);
+}
+
+template<typename T, typename Allocator>
+inline size_t ConcurrentVector<T, Allocator>::Capacity() const noexcept
+{
+    size_t segment = 0;
+    while (segment < MAX_SEGMENTS && segments_[segment].load(std::memory_order_acquire) != nullptr)
+    {
+        ++segment;
+    }
+    return SegmentBegin(segment);
+}
+
+template<typename T, typename Allocator>
+inline void ConcurrentVector<T, Allocator>::Reserve(size_t new_capacity)
+{
+    if (new_capacity == 0)
+    {
+        return;
+    }
+    const size_t last = SegmentOf(new_capacity - 1);
+    for (size_t segment = 0; segment <= last; ++segment)
+    {
+        EnsureSegment(segment);
+    }
+}
+
+template<typename T, typename Allocator>
+inline void ConcurrentVector<T, Allocator>::PushBack(const T& value)
+{
+    EmplaceBack(value);
+}
+
+template<typename T, typename Allocator>
+inline void ConcurrentVector<T, Allocator>::PushBack(T&& value)
+{
+    EmplaceBack(std::move(value));
+}
+
+template<typename T, typename Allocator>
+template<typename... Args>
+inline T& ConcurrentVector<T, Allocator>::EmplaceBack(Args&&... args)
+{
+    T* elem = nullptr;
+    size_t index = 0;
+    if constexpr (std::is_nothrow_constructible_v<T, Args&&...>)
+    {
+        index = ReserveSlot();
+        elem = new (SlotAt(index).storage) T(std::forward<Args>(args)...);
+    }
+    else
+    {
+        static_assert(std::is_nothrow_move_constructible_v<T>,
+            "ConcurrentVector requires nothrow construction from the arguments or a nothrow move constructor");
+        //    ,   ,       
+        T value(std::forward<Args>(args)...);
+        index = ReserveSlot();
+        elem = new (SlotAt(index).storage) T(std::move(value));
+    }
+    Publish(index);
+    return *elem;
+}
+
+template<typename T, typename Allocator>
+inline Vector<T, Allocator> ConcurrentVector<T, Allocator>::Flatten() const
+{
+    const size_t size = Size();
+    const Allocator alloc(alloc_);
+    Vector<T, Allocator> result(alloc);
+    result.Reserve(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        result.EmplaceBack((*this)[i]);
+    }
+    return result;
+}
+
+template<typename T, typename Allocator>
+inline void ConcurrentVector<T, Allocator>::Clear() noexcept
+{
+    const size_t size = reserved_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < size; ++i)
+    {
+        Slot& slot = SlotAt(i);
+        std::destroy_at(std::launder(reinterpret_cast<T*>(slot.storage)));
+        slot.ready.store(false, std::memory_order_relaxed);
+    }
+    reserved_.store(0, std::memory_order_relaxed);
+    size_.store(0, std::memory_order_relaxed);
+}
+
+template<typename T, typename Allocator>
+inline const T& ConcurrentVector<T, Allocator>::operator[](size_t index) const noexcept
+{
+    return const_cast<ConcurrentVector&>(*this)[index];
+}
+
+template<typename T, typename Allocator>
+inline T& ConcurrentVector<T, Allocator>::operator[](size_t index) noexcept
+{
+    assert(index < Size());
+    return *std::launder(reinterpret_cast<T*>(SlotAt(index).storage));
+}
+
+template<typename T, typename Allocator>
+inline ConcurrentVector<T, Allocator>::~ConcurrentVector()
+{
+    Clear();
+    for (size_t segment = 0; segment < MAX_SEGMENTS; ++segment)
+    {
+        if (Slot* slots = segments_[segment].load(std::memory_order_relaxed))
+        {
+            SlotTraits::deallocate(alloc_, slots, SegmentCapacity(segment));
+        }
+    }
+}
+
+template<typename T, typename Allocator>
+inline size_t ConcurrentVector<T, Allocator>::SegmentOf(size_t index) noexcept
+{
+    //  k    FIRST_SEGMENT_SIZE * (2^k - 1)
+    return detail::FloorLog2(index / FIRST_SEGMENT_SIZE + 1);
+}
+
+template<typename T, typename Allocator>
+inline size_t ConcurrentVector<T, Allocator>::SegmentBegin(size_t segment) noexcept
+{
+    return FIRST_SEGMENT_SIZE * ((size_t(1) << segment) - 1);
+}
+
+template<typename T, typename Allocator>
+inline size_t ConcurrentVector<T, Allocator>::SegmentCapacity(size_t segment) noexcept
+{
+    return FIRST_SEGMENT_SIZE << segment;
+}
+
+template<typename T, typename Allocator>
+inline typename ConcurrentVector<T, Allocator>::Slot& ConcurrentVector<T, Allocator>::SlotAt(size_t index) const noexcept
+{
+    const size_t segment = SegmentOf(index);
+    Slot* slots = segments_[segment].load(std::memory_order_acquire);
+    assert(slots != nullptr);
+    return slots[index - SegmentBegin(segment)];
+}
+
+template<typename T, typename Allocator>
+inline void ConcurrentVector<T, Allocator>::EnsureSegment(size_t segment)
+{
+    if (segment >= MAX_SEGMENTS)
+    {
+        throw std::length_error("ConcurrentVector is too large");
+    }
+    if (segments_[segment].load(std::memory_order_acquire) != nullptr)
+    {
+        return;
+    }
+    const size_t capacity = SegmentCapacity(segment);
+    Slot* slots = SlotTraits::allocate(alloc_, capacity);
+    //    value- 
+    std::uninitialized_value_construct_n(slots, capacity);
+    Slot* expected = nullptr;
+    if (!segments_[segment].compare_exchange_strong(expected, slots, std::memory_order_acq_rel, std::memory_order_acquire))
+    {
+        //     
+        SlotTraits::deallocate(alloc_, slots, capacity);
+    }
+}
+
+template<typename T, typename Allocator>
+inline size_t ConcurrentVector<T, Allocator>::ReserveSlot()
+{
+    size_t index = reserved_.load(std::memory_order_relaxed);
+    do
+    {
+        //    ,   ,      
+        EnsureSegment(SegmentOf(index));
+    } while (!reserved_.compare_exchange_weak(index, index + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+    return index;
+}
+
+template<typename T, typename Allocator>
+inline void ConcurrentVector<T, Allocator>::Publish(size_t index) noexcept
+{
+    //      : , 
+    //  ,    , -    
+    SlotAt(index).ready.store(true);
+    size_t size = size_.load();
+    while (size < reserved_.load() && SlotAt(size).ready.load())
+    {
+        if (size_.compare_exchange_weak(size, size + 1))
+        {
+            ++size;
+        }
+    }
+}
@@ -0,0 +1,1047 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "span.h"
+#include "vector.h"
+
+namespace detail {
+
+    //     keys[0, n),   key.
+    //      :     cmov,
+    //      n,     ,
+    //       
+    template <typename K, typename Compare>
+    size_t BranchlessLowerBound(const K* keys, size_t n, const K& key, const Compare& comp) {
+        if (n == 0) {
+            return 0;
+        }
+        const K* base = keys;
+        while (n > 1) {
+            const size_t half = n / 2;
+            base = comp(base[half], key) ? base + half : base;
+            n -= half;
+        }
+        return static_cast<size_t>(base - keys) + (comp(*base, key) ? 1 : 0);
+    }
+
+    //  batch         
+    template <typename T, typename A, typename Less>
+    void SortUnique(Vector<T, A>& batch, const Less& less) {
+        std::stable_sort(batch.begin(), batch.end(), less);
+        const auto last = std::unique(batch.begin(), batch.end(), [&less](const T& lhs, const T& rhs) {
+            return !less(lhs, rhs) && !less(rhs, lhs);
+        });
+        batch.Erase(last, batch.end());
+    }
+
+    //    existing[0, n)  added[0, m)  .  
+    //   ,        
+    template <typename K, typename T, typename KeyOf, typename Compare>
+    size_t MergedUniqueCount(const K* existing, size_t n, const T* added, size_t m, const KeyOf& key_of, const Compare& comp) {
+        size_t count = n;
+        size_t i = 0;
+        for (size_t j = 0; j < m; ++j) {
+            const K& key = key_of(added[j]);
+            while (i < n && comp(existing[i], key)) {
+                ++i;
+            }
+            if (i == n || comp(key, existing[i])) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    //    : ,  Move,  ,   
+    template <bool Move, typename T>
+    decltype(auto) TakeExisting(T& value) noexcept {
+        if constexpr (Move || !std::is_copy_constructible_v<T>) {
+            return std::move(value);
+        }
+        else {
+            return std::as_const(value);
+        }
+    }
+
+}  // namespace detail
+
+//       Vector.  
+//       ,     
+//     ,   std::set    .
+//          O(n);    
+//   InsertBatch.    
+template <typename K, typename Compare = std::less<K>, typename Allocator = std::allocator<K>>
+class FlatSet {
+    using Storage = Vector<K, Allocator>;
+
+public:
+    using key_type = K;
+    using value_type = K;
+    using key_compare = Compare;
+    using allocator_type = Allocator;
+    using iterator = typename Storage::const_iterator;
+    using const_iterator = typename Storage::const_iterator;
+
+    FlatSet() = default;
+    explicit FlatSet(const Compare& comp, const Allocator& alloc = Allocator());
+    template <typename InputIt>
+    FlatSet(InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator());
+    FlatSet(std::initializer_list<K> init, const Compare& comp = Compare(), const Allocator& alloc = Allocator());
+
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    size_t Size() const noexcept;
+    bool Empty() const noexcept;
+    size_t Capacity() const noexcept;
+
+    void Reserve(size_t new_capacity);
+    void ShrinkToFit();
+    void Clear() noexcept;
+    void Swap(FlatSet& other) noexcept;
+
+    std::pair<iterator, bool> Insert(const K& key);
+    std::pair<iterator, bool> Insert(K&& key);
+    //   [first, last):  ,      
+    //  O(n + m log m)      
+    template <typename InputIt>
+    void InsertBatch(InputIt first, InputIt last);
+
+    size_t Erase(const K& key);
+    iterator Erase(const_iterator pos);
+
+    const_iterator Find(const K& key) const;
+    bool Contains(const K& key) const;
+    size_t Count(const K& key) const;
+    const_iterator LowerBound(const K& key) const;
+    const_iterator UpperBound(const K& key) const;
+
+    //   
+    Span<const K> Keys() const noexcept;
+
+    const Compare& KeyComp() const noexcept;
+
+private:
+    size_t LowerBoundIndex(const K& key) const;
+    bool FoundAt(size_t index, const K& key) const;
+
+    template <typename Key>
+    std::pair<iterator, bool> InsertUnique(Key&& key);
+
+private:
+    Storage keys_;
+    Compare comp_;
+};
+
+template <typename K, typename Compare, typename Allocator>
+bool operator==(const FlatSet<K, Compare, Allocator>& lhs, const FlatSet<K, Compare, Allocator>& rhs) {
+    return lhs.Size() == rhs.Size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename K, typename Compare, typename Allocator>
+bool operator!=(const FlatSet<K, Compare, Allocator>& lhs, const FlatSet<K, Compare, Allocator>& rhs) {
+    return !(lhs == rhs);
+}
+
+//      .      
+//  Vector   :      ,  
+//     .     
+// std::pair<const K&, V&>; Keys()  Values()   .
+//       O(n);     
+//  InsertBatch.    
+template <typename K, typename V, typename Compare = std::less<K>,
+    typename KeyAllocator = std::allocator<K>, typename ValueAllocator = std::allocator<V>>
+class FlatMap {
+    using KeyStorage = Vector<K, KeyAllocator>;
+    using ValueStorage = Vector<V, ValueAllocator>;
+
+    template <bool IsConst>
+    class Iterator {
+        using Map = std::conditional_t<IsConst, const FlatMap, FlatMap>;
+        using Mapped = std::conditional_t<IsConst, const V, V>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::pair<K, V>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const K&, Mapped&>;
+
+        // operator->    
+        class pointer {
+        public:
+            explicit pointer(reference ref) noexcept
+                : ref_(ref)  //
+            {
+            }
+            const reference* operator->() const noexcept {
+                return &ref_;
+            }
+
+        private:
+            reference ref_;
+        };
+
+        Iterator() noexcept = default;
+        Iterator(Map* map, size_t index) noexcept
+            : map_(map)
+            , index_(index)  //
+        {
+        }
+        //     
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) noexcept
+            : map_(other.map_)
+            , index_(other.index_)  //
+        {
+        }
+
+        reference operator*() const noexcept {
+            return reference(map_->keys_[index_], map_->values_[index_]);
+        }
+        pointer operator->() const noexcept {
+            return pointer(**this);
+        }
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        //    Keys()  Values()
+        size_t Index() const noexcept {
+            return index_;
+        }
+
+        Iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++index_;
+            return old;
+        }
+        Iterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --index_;
+            return old;
+        }
+        Iterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+        Iterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+        friend Iterator operator+(Iterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+        friend Iterator operator+(difference_type offset, Iterator it) noexcept {
+            return it += offset;
+        }
+        friend Iterator operator-(Iterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+        friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+        friend bool operator>(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+        friend bool operator<=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+        friend bool operator>=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+    private:
+        template <bool>
+        friend class Iterator;
+
+        Map* map_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using key_compare = Compare;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatMap() = default;
+    explicit FlatMap(const Compare& comp, const KeyAllocator& key_alloc = KeyAllocator(), const ValueAllocator& value_alloc = ValueAllocator());
+    template <typename InputIt>
+    FlatMap(InputIt first, InputIt last, const Compare& comp = Compare());
+    FlatMap(std::initializer_list<value_type> init, const Compare& comp = Compare());
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    size_t Size() const noexcept;
+    bool Empty() const noexcept;
+    size_t Capacity() const noexcept;
+
+    //       
+    void Reserve(size_t new_capacity);
+    void ShrinkToFit();
+    void Clear() noexcept;
+    void Swap(FlatMap& other) noexcept;
+
+    //   ;      V()
+    V& operator[](const K& key);
+    V& operator[](K&& key);
+    //   ;     std::out_of_range
+    V& At(const K& key);
+    const V& At(const K& key) const;
+
+    std::pair<iterator, bool> Insert(const value_type& value);
+    std::pair<iterator, bool> Insert(value_type&& value);
+    //    args,     
+    template <typename... Args>
+    std::pair<iterator, bool> TryEmplace(const K& key, Args&&... args);
+    template <typename... Args>
+    std::pair<iterator, bool> TryEmplace(K&& key, Args&&... args);
+    //      
+    template <typename M>
+    std::pair<iterator, bool> InsertOrAssign(const K& key, M&& value);
+    template <typename M>
+    std::pair<iterator, bool> InsertOrAssign(K&& key, M&& value);
+    //   [first, last):    ,     
+    //     O(n + m log m)          .
+    //      
+    template <typename InputIt>
+    void InsertBatch(InputIt first, InputIt last);
+
+    size_t Erase(const K& key);
+    iterator Erase(const_iterator pos);
+
+    iterator Find(const K& key);
+    const_iterator Find(const K& key) const;
+    bool Contains(const K& key) const;
+    size_t Count(const K& key) const;
+    iterator LowerBound(const K& key);
+    const_iterator LowerBound(const K& key) const;
+    iterator UpperBound(const K& key);
+    const_iterator UpperBound(const K& key) const;
+
+    //         
+    Span<const K> Keys() const noexcept;
+    Span<V> Values() noexcept;
+    Span<const V> Values() const noexcept;
+
+    const Compare& KeyComp() const noexcept;
+
+private:
+    size_t LowerBoundIndex(const K& key) const;
+    bool FoundAt(size_t index, const K& key) const;
+
+    //     index,     
+    template <typename Key, typename... Args>
+    void InsertAt(size_t index, Key&& key, Args&&... args);
+
+    template <typename Key, typename... Args>
+    std::pair<iterator, bool> EmplaceUnique(Key&& key, Args&&... args);
+    template <typename Key, typename M>
+    std::pair<iterator, bool> AssignOrInsert(Key&& key, M&& value);
+
+private:
+    KeyStorage keys_;
+    ValueStorage values_;
+    Compare comp_;
+};
+
+template <typename K, typename V, typename Compare, typename KA, typename VA>
+bool operator==(const FlatMap<K, V, Compare, KA, VA>& lhs, const FlatMap<K, V, Compare, KA, VA>& rhs) {
+    return lhs.Size() == rhs.Size() && std::equal(lhs.Keys().begin(), lhs.Keys().end(), rhs.Keys().begin())
+        && std::equal(lhs.Values().begin(), lhs.Values().end(), rhs.Values().begin());
+}
+
+template <typename K, typename V, typename Compare, typename KA, typename VA>
+bool operator!=(const FlatMap<K, V, Compare, KA, VA>& lhs, const FlatMap<K, V, Compare, KA, VA>& rhs) {
+    return !(lhs == rhs);
+}
+
+// ---------------------------------------------------------------------------------------------
+// FlatSet
+
+template<typename K, typename Compare, typename Allocator>
+inline FlatSet<K, Compare, Allocator>::FlatSet(const Compare& comp, const Allocator& alloc)
+    : keys_(alloc)
+    , comp_(comp)
+{
+}
+
+template<typename K, typename Compare, typename Allocator>
+template<typename InputIt>
+inline FlatSet<K, Compare, Allocator>::FlatSet(InputIt first, InputIt last, const Compare& comp, const Allocator& alloc)
+    : keys_(alloc)
+    , comp_(comp)
+{
+    InsertBatch(first, last);
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline FlatSet<K, Compare, Allocator>::FlatSet(std::initializer_list<K> init, const Compare& comp, const Allocator& alloc)
+    : FlatSet(init.begin(), init.end(), comp, alloc)
+{
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline typename FlatSet<K, Compare, Allocator>::const_iterator FlatSet<K, Compare, Allocator>::begin() const noexcept
+{
+    return keys_.begin();
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline typename FlatSet<K, Compare, Allocator>::const_iterator FlatSet<K, Compare, Allocator>::end() const noexcept
+{
+    return keys_.end();
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline typename FlatSet<K, Compare, Allocator>::const_iterator FlatSet<K, Compare, Allocator>::cbegin() const noexcept
+{
+    return keys_.begin();
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline typename FlatSet<K, Compare, Allocator>::const_iterator FlatSet<K, Compare, Allocator>::cend() const noexcept
+{
+    return keys_.end();
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline size_t FlatSet<K, Compare, Allocator>::Size() const noexcept
+{
+    return keys_.Size();
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline bool FlatSet<K, Compare, Allocator>::Empty() const noexcept
+{
+    return keys_.Size() == 0;
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline size_t FlatSet<K, Compare, Allocator>::Capacity() const noexcept
+{
+    return keys_.Capacity();
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline void FlatSet<K, Compare, Allocator>::Reserve(size_t new_capacity)
+{
+    keys_.Reserve(new_capacity);
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline void FlatSet<K, Compare, Allocator>::ShrinkToFit()
+{
+    keys_.ShrinkToFit();
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline void FlatSet<K, Compare, Allocator>::Clear() noexcept
+{
+    keys_.Clear();
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline void FlatSet<K, Compare, Allocator>::Swap(FlatSet& other) noexcept
+{
+    keys_.Swap(other.keys_);
+    std::swap(comp_, other.comp_);
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline std::pair<typename FlatSet<K, Compare, Allocator>::iterator, bool> FlatSet<K, Compare, Allocator>::Insert(const K& key)
+{
+    return InsertUnique(key);
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline std::pair<typename FlatSet<K, Compare, Allocator>::iterator, bool> FlatSet<K, Compare, Allocator>::Insert(K&& key)
+{
+    return InsertUnique(std::move(key));
+}
+
+template<typename K, typename Compare, typename Allocator>
+template<typename InputIt>
+inline void FlatSet<K, Compare, Allocator>::InsertBatch(InputIt first, InputIt last)
+{
+    Storage batch(keys_.GetAllocator());
+    batch.Append(first, last);
+    if (batch.Size() == 0)
+    {
+        return;
+    }
+    detail::SortUnique(batch, comp_);
+
+    //     :     
+    if (keys_.Size() == 0 || comp_(keys_[keys_.Size() - 1], batch[0]))
+    {
+        keys_.Append(std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+        return;
+    }
+
+    const size_t merged_size = detail::MergedUniqueCount(keys_.Data(), keys_.Size(), batch.Data(), batch.Size(),
+        [](const K& key) -> const K& {
+            return key;
+        }, comp_);
+    if (merged_size == keys_.Size())
+    {
+        return;
+    }
+
+    //   ,      ,
+    //  :     
+    Storage merged(keys_.GetAllocator());
+    merged.Reserve(merged_size);
+    size_t i = 0;
+    size_t j = 0;
+    while (i < keys_.Size() && j < batch.Size())
+    {
+        if (comp_(keys_[i], batch[j]))
+        {
+            merged.PushBack(std::move_if_noexcept(keys_[i++]));
+        }
+        else if (comp_(batch[j], keys_[i]))
+        {
+            merged.PushBack(std::move(batch[j++]));
+        }
+        else
+        {
+            merged.PushBack(std::move_if_noexcept(keys_[i++]));
+            ++j;
+        }
+    }
+    for (; i < keys_.Size(); ++i)
+    {
+        merged.PushBack(std::move_if_noexcept(keys_[i]));
+    }
+    for (; j < batch.Size(); ++j)
+    {
+        merged.PushBack(std::move(batch[j]));
+    }
+    keys_.Swap(merged);
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline size_t FlatSet<K, Compare, Allocator>::Erase(const K& key)
+{
+    const size_t index = LowerBoundIndex(key);
+    if (!FoundAt(index, key))
+    {
+        return 0;
+    }
+    keys_.Erase(keys_.begin() + index);
+    return 1;
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline typename FlatSet<K, Compare, Allocator>::iterator FlatSet<K, Compare, Allocator>::Erase(const_iterator pos)
+{
+    return keys_.Erase(pos);
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline typename FlatSet<K, Compare, Allocator>::const_iterator FlatSet<K, Compare, Allocator>::Find(const K& key) const
+{
+    const size_t index = LowerBoundIndex(key);
+    return FoundAt(index, key) ? keys_.begin() + index : keys_.end();
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline bool FlatSet<K, Compare, Allocator>::Contains(const K& key) const
+{
+    return FoundAt(LowerBoundIndex(key), key);
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline size_t FlatSet<K, Compare, Allocator>::Count(const K& key) const
+{
+    return Contains(key) ? 1 : 0;
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline typename FlatSet<K, Compare, Allocator>::const_iterator FlatSet<K, Compare, Allocator>::LowerBound(const K& key) const
+{
+    return keys_.begin() + LowerBoundIndex(key);
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline typename FlatSet<K, Compare, Allocator>::const_iterator FlatSet<K, Compare, Allocator>::UpperBound(const K& key) const
+{
+    const size_t index = LowerBoundIndex(key);
+    return keys_.begin() + (FoundAt(index, key) ? index + 1 : index);
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline Span<const K> FlatSet<K, Compare, Allocator>::Keys() const noexcept
+{
+    return keys_.AsSpan();
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline const Compare& FlatSet<K, Compare, Allocator>::KeyComp() const noexcept
+{
+    return comp_;
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline size_t FlatSet<K, Compare, Allocator>::LowerBoundIndex(const K& key) const
+{
+    return detail::BranchlessLowerBound(keys_.Data(), keys_.Size(), key, comp_);
+}
+
+template<typename K, typename Compare, typename Allocator>
+inline bool FlatSet<K, Compare, Allocator>::FoundAt(size_t index, const K& key) const
+{
+    return index < keys_.Size() && !comp_(key, keys_[index]);
+}
+
+template<typename K, typename Compare, typename Allocator>
+template<typename Key>
+inline std::pair<typename FlatSet<K, Compare, Allocator>::iterator, bool> FlatSet<K, Compare, Allocator>::InsertUnique(Key&& key)
+{
+    const size_t index = LowerBoundIndex(key);
+    if (FoundAt(index, key))
+    {
+        return { keys_.begin() + index, false };
+    }
+    return { keys_.Insert(keys_.begin() + index, std::forward<Key>(key)), true };
+}
+
+// ---------------------------------------------------------------------------------------------
+// FlatMap
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline FlatMap<K, V, Compare, KA, VA>::FlatMap(const Compare& comp, const KA& key_alloc, const VA& value_alloc)
+    : keys_(key_alloc)
+    , values_(value_alloc)
+    , comp_(comp)
+{
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+template<typename InputIt>
+inline FlatMap<K, V, Compare, KA, VA>::FlatMap(InputIt first, InputIt last, const Compare& comp)
+    : comp_(comp)
+{
+    InsertBatch(first, last);
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline FlatMap<K, V, Compare, KA, VA>::FlatMap(std::initializer_list<value_type> init, const Compare& comp)
+    : FlatMap(init.begin(), init.end(), comp)
+{
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline typename FlatMap<K, V, Compare, KA, VA>::iterator FlatMap<K, V, Compare, KA, VA>::begin() noexcept
+{
+    return iterator(this, 0);
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline typename FlatMap<K, V, Compare, KA, VA>::iterator FlatMap<K, V, Compare, KA, VA>::end() noexcept
+{
+    return iterator(this, keys_.Size());
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline typename FlatMap<K, V, Compare, KA, VA>::const_iterator FlatMap<K, V, Compare, KA, VA>::begin() const noexcept
+{
+    return const_iterator(this, 0);
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline typename FlatMap<K, V, Compare, KA, VA>::const_iterator FlatMap<K, V, Compare, KA, VA>::end() const noexcept
+{
+    return const_iterator(this, keys_.Size());
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline typename FlatMap<K, V, Compare, KA, VA>::const_iterator FlatMap<K, V, Compare, KA, VA>::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline typename FlatMap<K, V, Compare, KA, VA>::const_iterator FlatMap<K, V, Compare, KA, VA>::cend() const noexcept
+{
+    return end();
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline size_t FlatMap<K, V, Compare, KA, VA>::Size() const noexcept
+{
+    return keys_.Size();
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline bool FlatMap<K, V, Compare, KA, VA>::Empty() const noexcept
+{
+    return keys_.Size() == 0;
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline size_t FlatMap<K, V, Compare, KA, VA>::Capacity() const noexcept
+{
+    return std::min(keys_.Capacity(), values_.Capacity());
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline void FlatMap<K, V, Compare, KA, VA>::Reserve(size_t new_capacity)
+{
+    keys_.Reserve(new_capacity);
+    values_.Reserve(new_capacity);
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline void FlatMap<K, V, Compare, KA, VA>::ShrinkToFit()
+{
+    keys_.ShrinkToFit();
+    values_.ShrinkToFit();
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline void FlatMap<K, V, Compare, KA, VA>::Clear() noexcept
+{
+    keys_.Clear();
+    values_.Clear();
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline void FlatMap<K, V, Compare, KA, VA>::Swap(FlatMap& other) noexcept
+{
+    keys_.Swap(other.keys_);
+    values_.Swap(other.values_);
+    std::swap(comp_, other.comp_);
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline V& FlatMap<K, V, Compare, KA, VA>::operator[](const K& key)
+{
+    return values_[EmplaceUnique(key).first.Index()];
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline V& FlatMap<K, V, Compare, KA, VA>::operator[](K&& key)
+{
+    return values_[EmplaceUnique(std::move(key)).first.Index()];
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline V& FlatMap<K, V, Compare, KA, VA>::At(const K& key)
+{
+    return const_cast<V&>(std::as_const(*this).At(key));
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline const V& FlatMap<K, V, Compare, KA, VA>::At(const K& key) const
+{
+    const size_t index = LowerBoundIndex(key);
+    if (!FoundAt(index, key))
+    {
+        throw std::out_of_range("FlatMap::At: key not found");
+    }
+    return values_[index];
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline std::pair<typename FlatMap<K, V, Compare, KA, VA>::iterator, bool> FlatMap<K, V, Compare, KA, VA>::Insert(const value_type& value)
+{
+    return EmplaceUnique(value.first, value.second);
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline std::pair<typename FlatMap<K, V, Compare, KA, VA>::iterator, bool> FlatMap<K, V, Compare, KA, VA>::Insert(value_type&& value)
+{
+    return EmplaceUnique(std::move(value.first), std::move(value.second));
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+template<typename... Args>
+inline std::pair<typename FlatMap<K, V, Compare, KA, VA>::iterator, bool> FlatMap<K, V, Compare, KA, VA>::TryEmplace(const K& key, Args&&... args)
+{
+    return EmplaceUnique(key, std::forward<Args>(args)...);
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+template<typename... Args>
+inline std::pair<typename FlatMap<K, V, Compare, KA, VA>::iterator, bool> FlatMap<K, V, Compare, KA, VA>::TryEmplace(K&& key, Args&&... args)
+{
+    return EmplaceUnique(std::move(key), std::forward<Args>(args)...);
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+template<typename M>
+inline std::pair<typename FlatMap<K, V, Compare, KA, VA>::iterator, bool> FlatMap<K, V, Compare, KA, VA>::InsertOrAssign(const K& key, M&& value)
+{
+    return AssignOrInsert(key, std::forward<M>(value));
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+template<typename M>
+inline std::pair<typename FlatMap<K, V, Compare, KA, VA>::iterator, bool> FlatMap<K, V, Compare, KA, VA>::InsertOrAssign(K&& key, M&& value)
+{
+    return AssignOrInsert(std::move(key), std::forward<M>(value));
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+template<typename InputIt>
+inline void FlatMap<K, V, Compare, KA, VA>::InsertBatch(InputIt first, InputIt last)
+{
+    using Pair = std::pair<K, V>;
+    using PairAllocator = typename std::allocator_traits<KA>::template rebind_alloc<Pair>;
+    const auto by_key = [this](const Pair& lhs, const Pair& rhs) {
+        return comp_(lhs.first, rhs.first);
+    };
+
+    Vector<Pair, PairAllocator> batch(PairAllocator(keys_.GetAllocator()));
+    batch.Append(first, last);
+    if (batch.Size() == 0)
+    {
+        return;
+    }
+    detail::SortUnique(batch, by_key);
+
+    const size_t merged_size = detail::MergedUniqueCount(keys_.Data(), keys_.Size(), batch.Data(), batch.Size(),
+        [](const Pair& pair) -> const K& {
+            return pair.first;
+        }, comp_);
+    if (merged_size == keys_.Size())
+    {
+        return;
+    }
+
+    KeyStorage keys(keys_.GetAllocator());
+    ValueStorage values(values_.GetAllocator());
+    keys.Reserve(merged_size);
+    values.Reserve(merged_size);
+    //   ,      
+    //  ,  :         keys_ 
+    //  .     ,      
+    constexpr bool MOVE_EXISTING = std::is_nothrow_move_constructible_v<K> && std::is_nothrow_move_constructible_v<V>;
+    const auto take_existing = [&](size_t index) {
+        keys.PushBack(detail::TakeExisting<MOVE_EXISTING>(keys_[index]));
+        values.PushBack(detail::TakeExisting<MOVE_EXISTING>(values_[index]));
+    };
+    const auto take_new = [&](size_t index) {
+        keys.PushBack(std::move(batch[index].first));
+        values.PushBack(std::move(batch[index].second));
+    };
+
+    size_t i = 0;
+    size_t j = 0;
+    while (i < keys_.Size() && j < batch.Size())
+    {
+        if (comp_(keys_[i], batch[j].first))
+        {
+            take_existing(i++);
+        }
+        else if (comp_(batch[j].first, keys_[i]))
+        {
+            take_new(j++);
+        }
+        else
+        {
+            take_existing(i++);
+            ++j;
+        }
+    }
+    for (; i < keys_.Size(); ++i)
+    {
+        take_existing(i);
+    }
+    for (; j < batch.Size(); ++j)
+    {
+        take_new(j);
+    }
+    keys_.Swap(keys);
+    values_.Swap(values);
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline size_t FlatMap<K, V, Compare, KA, VA>::Erase(const K& key)
+{
+    const size_t index = LowerBoundIndex(key);
+    if (!FoundAt(index, key))
+    {
+        return 0;
+    }
+    Erase(const_iterator(this, index));
+    return 1;
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline typename FlatMap<K, V, Compare, KA, VA>::iterator FlatMap<K, V, Compare, KA, VA>::Erase(const_iterator pos)
+{
+    const size_t index = pos.Index();
+    keys_.Erase(keys_.begin() + index);
+    values_.Erase(values_.begin() + index);
+    return iterator(this, index);
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline typename FlatMap<K, V, Compare, KA, VA>::iterator FlatMap<K, V, Compare, KA, VA>::Find(const K& key)
+{
+    const size_t index = LowerBoundIndex(key);
+    return FoundAt(index, key) ? iterator(this, index) : end();
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline typename FlatMap<K, V, Compare, KA, VA>::const_iterator FlatMap<K, V, Compare, KA, VA>::Find(const K& key) const
+{
+    const size_t index = LowerBoundIndex(key);
+    return FoundAt(index, key) ? const_iterator(this, index) : end();
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline bool FlatMap<K, V, Compare, KA, VA>::Contains(const K& key) const
+{
+    return FoundAt(LowerBoundIndex(key), key);
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline size_t FlatMap<K, V, Compare, KA, VA>::Count(const K& key) const
+{
+    return Contains(key) ? 1 : 0;
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline typename FlatMap<K, V, Compare, KA, VA>::iterator FlatMap<K, V, Compare, KA, VA>::LowerBound(const K& key)
+{
+    return iterator(this, LowerBoundIndex(key));
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline typename FlatMap<K, V, Compare, KA, VA>::const_iterator FlatMap<K, V, Compare, KA, VA>::LowerBound(const K& key) const
+{
+    return const_iterator(this, LowerBoundIndex(key));
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline typename FlatMap<K, V, Compare, KA, VA>::iterator FlatMap<K, V, Compare, KA, VA>::UpperBound(const K& key)
+{
+    const size_t index = LowerBoundIndex(key);
+    return iterator(this, FoundAt(index, key) ? index + 1 : index);
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline typename FlatMap<K, V, Compare, KA, VA>::const_iterator FlatMap<K, V, Compare, KA, VA>::UpperBound(const K& key) const
+{
+    const size_t index = LowerBoundIndex(key);
+    return const_iterator(this, FoundAt(index, key) ? index + 1 : index);
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline Span<const K> FlatMap<K, V, Compare, KA, VA>::Keys() const noexcept
+{
+    return keys_.AsSpan();
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline Span<V> FlatMap<K, V, Compare, KA, VA>::Values() noexcept
+{
+    return values_.AsSpan();
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline Span<const V> FlatMap<K, V, Compare, KA, VA>::Values() const noexcept
+{
+    return values_.AsSpan();
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline const Compare& FlatMap<K, V, Compare, KA, VA>::KeyComp() const noexcept
+{
+    return comp_;
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline size_t FlatMap<K, V, Compare, KA, VA>::LowerBoundIndex(const K& key) const
+{
+    return detail::BranchlessLowerBound(keys_.Data(), keys_.Size(), key, comp_);
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+inline bool FlatMap<K, V, Compare, KA, VA>::FoundAt(size_t index, const K& key) const
+{
+    return index < keys_.Size() && !comp_(key, keys_[index]);
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+template<typename Key, typename... Args>
+inline void FlatMap<K, V, Compare, KA, VA>::InsertAt(size_t index, Key&& key, Args&&... args)
+{
+    //     ,       
+    keys_.Emplace(keys_.begin() + index, std::forward<Key>(key));
+    try
+    {
+        values_.Emplace(values_.begin() + index, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        keys_.Erase(keys_.begin() + index);
+        throw;
+    }
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+template<typename Key, typename... Args>
+inline std::pair<typename FlatMap<K, V, Compare, KA, VA>::iterator, bool> FlatMap<K, V, Compare, KA, VA>::EmplaceUnique(Key&& key, Args&&... args)
+{
+    const size_t index = LowerBoundIndex(key);
+    if (FoundAt(index, key))
+    {
+        return { iterator(this, index), false };
+    }
+    InsertAt(index, std::forward<Key>(key), std::forward<Args>(args)...);
+    return { iterator(this, index), true };
+}
+
+template<typename K, typename V, typename Compare, typename KA, typename VA>
+template<typename Key, typename M>
+inline std::pair<typename FlatMap<K, V, Compare, KA, VA>::iterator, bool> FlatMap<K, V, Compare, KA, VA>::AssignOrInsert(Key&& key, M&& value)
+{
+    const size_t index = LowerBoundIndex(key);
+    if (FoundAt(index, key))
+    {
+        values_[index] = std::forward<M>(value);
+        return { iterator(this, index), false };
+    }
+    InsertAt(index, std::forward<Key>(key), std::forward<M>(value));
+    return { iterator(this, index), true };
+}
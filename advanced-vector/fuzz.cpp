@@ -0,0 +1,723 @@
+﻿#include "vector.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Рандомизированная проверка безопасности исключений Vector. Каждая операция сначала выполняется
+// над копией вектора без исключений, и результат сравнивается с std::vector<int>, который служит
+// эталоном. Затем операция повторяется над новыми копиями, и в каждой копии выбрасывается исключение
+// на N-м копировании, перемещении или создании элемента. Для небольших операций перебираются все N.
+// Операции со строгой гарантией должны оставить вектор прежним, остальные — сохранить все элементы
+// живыми, а число живых объектов — равным размеру. Любое нарушение печатает seed, шаг и операцию
+// и завершает программу через std::abort, так что её удобно запускать под санитайзерами:
+//     g++ -std=c++17 -g -pthread -fsanitize=address,undefined advanced-vector/fuzz.cpp -o fuzz && ./fuzz
+// Параметры командной строки:
+//     --seed=N     начальное значение генератора (по умолчанию 1)
+//     --steps=N    число операций для каждого типа элементов (по умолчанию 2000)
+//     --type=NAME  проверить только тип NAME (may_throw, nothrow_move, relocatable)
+
+namespace {
+
+    struct InjectedError : std::runtime_error {
+        InjectedError()
+            : std::runtime_error("Injected exception") {
+        }
+    };
+
+    // Описание текущей операции для сообщения об ошибке
+    std::string& Context() {
+        static std::string context;
+        return context;
+    }
+
+    [[noreturn]] void Fail(const char* message) {
+        std::fprintf(stderr, "fuzz: %s\n    at %s\n", message, Context().c_str());
+        std::abort();
+    }
+
+    void Require(bool condition, const char* message) {
+        if (!condition) {
+            Fail(message);
+        }
+    }
+
+    // Точка внедрения исключений. Счётчики атомарны, потому что параллельные операции Vector
+    // создают элементы в нескольких потоках
+    struct Injection {
+        // Номер события, на котором выбрасывается исключение; 0 отключает внедрение
+        static inline std::atomic<int64_t> countdown{ 0 };
+        // Число событий, то есть копирований, перемещений и созданий элементов
+        static inline std::atomic<int64_t> events{ 0 };
+        // Число живых элементов
+        static inline std::atomic<int64_t> live{ 0 };
+        static inline std::atomic<uint64_t> thrown{ 0 };
+
+        static void Point() {
+            events.fetch_add(1, std::memory_order_relaxed);
+            if (countdown.load(std::memory_order_relaxed) > 0 && countdown.fetch_sub(1, std::memory_order_relaxed) == 1) {
+                thrown.fetch_add(1, std::memory_order_relaxed);
+                throw InjectedError();
+            }
+        }
+    };
+
+    enum class MoveKind {
+        // Перемещение может выбросить исключение, поэтому Vector переносит элементы копированием
+        MAY_THROW,
+        NOTHROW,
+        // Перемещение может выбросить исключение, но при росте элементы переносятся memcpy
+        RELOCATABLE,
+    };
+
+    // Элемент, который отмечает своё время жизни, как TestObj::IsAlive в main.cpp, и выбрасывает
+    // исключение по команде Injection при копировании, перемещении и создании
+    template <MoveKind Kind>
+    class Tracked {
+        static constexpr bool NOTHROW_MOVE = Kind == MoveKind::NOTHROW;
+
+    public:
+        Tracked() {
+            Injection::Point();
+            Born();
+        }
+        explicit Tracked(int value)
+            : value_(value) {
+            Injection::Point();
+            Born();
+        }
+        Tracked(const Tracked& other)
+            : value_(other.Value()) {
+            Injection::Point();
+            Born();
+        }
+        Tracked(Tracked&& other) noexcept(NOTHROW_MOVE)
+            : value_(other.Value()) {
+            if constexpr (!NOTHROW_MOVE) {
+                Injection::Point();
+            }
+            Born();
+        }
+        Tracked& operator=(const Tracked& rhs) {
+            Require(IsAlive(), "assignment to a dead element");
+            const int value = rhs.Value();
+            Injection::Point();
+            value_ = value;
+            return *this;
+        }
+        Tracked& operator=(Tracked&& rhs) noexcept(NOTHROW_MOVE) {
+            Require(IsAlive(), "assignment to a dead element");
+            const int value = rhs.Value();
+            if constexpr (!NOTHROW_MOVE) {
+                Injection::Point();
+            }
+            value_ = value;
+            return *this;
+        }
+        ~Tracked() {
+            Require(IsAlive(), "element destroyed twice or never constructed");
+            cookie_ = 0;
+            Injection::live.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        int Value() const {
+            Require(IsAlive(), "dead element read");
+            return value_;
+        }
+
+        [[nodiscard]] bool IsAlive() const noexcept {
+            return cookie_ == ALIVE_COOKIE;
+        }
+
+    private:
+        static constexpr uint32_t ALIVE_COOKIE = 0xA11CE5ED;
+
+        void Born() noexcept {
+            cookie_ = ALIVE_COOKIE;
+            Injection::live.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        int value_ = 0;
+        uint32_t cookie_ = 0;
+    };
+
+}  // namespace
+
+template <>
+struct IsTriviallyRelocatable<Tracked<MoveKind::RELOCATABLE>> : std::true_type {
+};
+
+// Большие векторы переносятся при росте в нескольких потоках
+template <>
+struct ParallelRelocation<Tracked<MoveKind::MAY_THROW>> : std::true_type {
+};
+
+namespace {
+
+    // Однопроходный итератор поверх It, чтобы проверить ветки Insert и Append для input-итераторов
+    template <typename It>
+    class InputIterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = typename std::iterator_traits<It>::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::iterator_traits<It>::pointer;
+        using reference = typename std::iterator_traits<It>::reference;
+
+        explicit InputIterator(It it)
+            : it_(it) {
+        }
+
+        reference operator*() const {
+            return *it_;
+        }
+        InputIterator& operator++() {
+            ++it_;
+            return *this;
+        }
+        InputIterator operator++(int) {
+            InputIterator old = *this;
+            ++it_;
+            return old;
+        }
+        bool operator==(const InputIterator& other) const {
+            return it_ == other.it_;
+        }
+        bool operator!=(const InputIterator& other) const {
+            return it_ != other.it_;
+        }
+
+    private:
+        It it_;
+    };
+
+    enum class Op {
+        PUSH_BACK_COPY,
+        PUSH_BACK_MOVE,
+        EMPLACE_BACK,
+        EMPLACE,
+        INSERT_COPY,
+        INSERT_MOVE,
+        INSERT_FILL,
+        INSERT_RANGE,
+        INSERT_INPUT_RANGE,
+        APPEND,
+        ASSIGN_RANGE,
+        ASSIGN_FILL,
+        ERASE,
+        ERASE_RANGE,
+        ERASE_IF,
+        POP_BACK,
+        RESIZE,
+        RESERVE,
+        SHRINK_TO_FIT,
+        CLEAR,
+        COPY_ASSIGN,
+        COPY_CONSTRUCT,
+        MOVE_ASSIGN,
+        SWAP,
+        // Параллельные операции выполняются над векторами, достаточно большими для нескольких потоков
+        PARALLEL_COPY_FROM,
+        PARALLEL_RESIZE,
+        PARALLEL_CONSTRUCT,
+    };
+
+    constexpr std::string_view OP_NAMES[] = {
+        "PushBack(const T&)", "PushBack(T&&)", "EmplaceBack", "Emplace", "Insert(const T&)", "Insert(T&&)",
+        "Insert(count, value)", "Insert(forward range)", "Insert(input range)", "Append", "Assign(range)",
+        "Assign(count, value)", "Erase", "Erase(range)", "EraseIf", "PopBack", "Resize", "Reserve",
+        "ShrinkToFit", "Clear", "operator=(const Vector&)", "Vector(const Vector&)", "operator=(Vector&&)",
+        "Swap", "ParallelCopyFrom", "ParallelResize", "Vector(PARALLEL, const Vector&)",
+    };
+
+    constexpr size_t LAST_SERIAL_OP = static_cast<size_t>(Op::SWAP);
+    constexpr size_t LAST_OP = static_cast<size_t>(Op::PARALLEL_CONSTRUCT);
+
+    // Наибольший размер вектора в обычных операциях
+    constexpr size_t MAX_SIZE = 64;
+    // Размер, при котором параллельные операции делятся на три части
+    constexpr size_t PARALLEL_SIZE = 3 * detail::PARALLEL_MIN_CHUNK + 7;
+    // Число попыток внедрения для операций, в которых событий больше MAX_SIZE
+    constexpr size_t SAMPLED_INJECTIONS = 8;
+
+    struct Step {
+        Op op = Op::PUSH_BACK_COPY;
+        size_t pos = 0;
+        size_t count = 0;
+        int value = 0;
+        std::vector<int> values;
+    };
+
+    struct Options {
+        uint64_t seed = 1;
+        size_t steps = 2000;
+        std::string type;
+    };
+
+    struct Totals {
+        uint64_t trials = 0;
+        uint64_t strong_checks = 0;
+        uint64_t basic_checks = 0;
+    };
+
+    size_t Uniform(std::mt19937_64& random, size_t low, size_t high) {
+        return std::uniform_int_distribution<size_t>(low, high)(random);
+    }
+
+    Step MakeStep(std::mt19937_64& random, size_t size, int& next_value) {
+        Step step;
+        if (size > MAX_SIZE) {
+            // После параллельной операции вектор большой: его снова копируют параллельно, растят
+            // с переносом в нескольких потоках или уменьшают
+            constexpr Op LARGE_OPS[] = { Op::RESIZE, Op::RESIZE, Op::PARALLEL_CONSTRUCT, Op::RESERVE };
+            step.op = LARGE_OPS[Uniform(random, 0, std::size(LARGE_OPS) - 1)];
+            step.count = step.op == Op::RESIZE ? Uniform(random, 0, MAX_SIZE / 2) : size * 2;
+            return step;
+        }
+        const bool parallel = Uniform(random, 0, 199) == 0;
+        step.op = static_cast<Op>(parallel ? Uniform(random, LAST_SERIAL_OP + 1, LAST_OP) : Uniform(random, 0, LAST_SERIAL_OP));
+        if (size == 0 && (step.op == Op::ERASE || step.op == Op::ERASE_RANGE || step.op == Op::POP_BACK)) {
+            step.op = Op::PUSH_BACK_COPY;
+        }
+        step.value = next_value++;
+        step.pos = Uniform(random, 0, step.op == Op::ERASE ? size - 1 : size);
+        switch (step.op) {
+        case Op::INSERT_FILL:
+        case Op::ASSIGN_FILL:
+            step.count = Uniform(random, 0, 8);
+            break;
+        case Op::ERASE_RANGE:
+            step.count = Uniform(random, 0, size - step.pos);
+            break;
+        case Op::RESIZE:
+        case Op::RESERVE:
+            step.count = Uniform(random, 0, std::min(size * 2 + 8, MAX_SIZE));
+            break;
+        case Op::PARALLEL_RESIZE:
+            step.count = PARALLEL_SIZE;
+            break;
+        default:
+            break;
+        }
+        size_t range_size = 0;
+        switch (step.op) {
+        case Op::INSERT_RANGE:
+        case Op::INSERT_INPUT_RANGE:
+        case Op::APPEND:
+            range_size = Uniform(random, 0, 8);
+            break;
+        case Op::ASSIGN_RANGE:
+        case Op::COPY_ASSIGN:
+        case Op::MOVE_ASSIGN:
+        case Op::SWAP:
+            range_size = Uniform(random, 0, std::min(size * 2 + 8, MAX_SIZE));
+            break;
+        case Op::PARALLEL_COPY_FROM:
+            range_size = PARALLEL_SIZE;
+            break;
+        default:
+            break;
+        }
+        for (size_t i = 0; i < range_size; ++i) {
+            step.values.push_back(next_value++);
+        }
+        return step;
+    }
+
+    template <typename T>
+    std::vector<T> MakeSource(const std::vector<int>& values) {
+        std::vector<T> source;
+        source.reserve(values.size());
+        for (int value : values) {
+            source.emplace_back(value);
+        }
+        return source;
+    }
+
+    template <typename T>
+    Vector<T> MakeVector(const std::vector<int>& values) {
+        Vector<T> v;
+        v.Reserve(values.size());
+        for (int value : values) {
+            v.EmplaceBack(value);
+        }
+        return v;
+    }
+
+    bool EraseIfPredicate(int value, const Step& step) {
+        return (value - step.value) % 3 == 0;
+    }
+
+    template <typename T>
+    void Apply(const Step& step, Vector<T>& v) {
+        const auto pos = v.cbegin() + static_cast<std::ptrdiff_t>(step.pos);
+        switch (step.op) {
+        case Op::PUSH_BACK_COPY: {
+            const T value(step.value);
+            v.PushBack(value);
+            break;
+        }
+        case Op::PUSH_BACK_MOVE: {
+            T value(step.value);
+            v.PushBack(std::move(value));
+            break;
+        }
+        case Op::EMPLACE_BACK:
+            v.EmplaceBack(step.value);
+            break;
+        case Op::EMPLACE:
+            v.Emplace(pos, step.value);
+            break;
+        case Op::INSERT_COPY: {
+            const T value(step.value);
+            v.Insert(pos, value);
+            break;
+        }
+        case Op::INSERT_MOVE: {
+            T value(step.value);
+            v.Insert(pos, std::move(value));
+            break;
+        }
+        case Op::INSERT_FILL: {
+            const T value(step.value);
+            v.Insert(pos, step.count, value);
+            break;
+        }
+        case Op::INSERT_RANGE: {
+            const std::vector<T> source = MakeSource<T>(step.values);
+            v.Insert(pos, source.begin(), source.end());
+            break;
+        }
+        case Op::INSERT_INPUT_RANGE: {
+            const std::vector<T> source = MakeSource<T>(step.values);
+            using It = InputIterator<typename std::vector<T>::const_iterator>;
+            v.Insert(pos, It(source.begin()), It(source.end()));
+            break;
+        }
+        case Op::APPEND: {
+            const std::vector<T> source = MakeSource<T>(step.values);
+            v.Append(source.begin(), source.end());
+            break;
+        }
+        case Op::ASSIGN_RANGE: {
+            const std::vector<T> source = MakeSource<T>(step.values);
+            v.Assign(source.begin(), source.end());
+            break;
+        }
+        case Op::ASSIGN_FILL: {
+            const T value(step.value);
+            v.Assign(step.count, value);
+            break;
+        }
+        case Op::ERASE:
+            v.Erase(pos);
+            break;
+        case Op::ERASE_RANGE:
+            v.Erase(pos, pos + static_cast<std::ptrdiff_t>(step.count));
+            break;
+        case Op::ERASE_IF:
+            EraseIf(v, [&step](const T& elem) {
+                return EraseIfPredicate(elem.Value(), step);
+                });
+            break;
+        case Op::POP_BACK:
+            v.PopBack();
+            break;
+        case Op::RESIZE:
+            v.Resize(step.count);
+            break;
+        case Op::RESERVE:
+            v.Reserve(step.count);
+            break;
+        case Op::SHRINK_TO_FIT:
+            v.ShrinkToFit();
+            break;
+        case Op::CLEAR:
+            v.Clear();
+            break;
+        case Op::COPY_ASSIGN: {
+            const Vector<T> other = MakeVector<T>(step.values);
+            v = other;
+            break;
+        }
+        case Op::COPY_CONSTRUCT: {
+            Vector<T> copy(v);
+            v.Swap(copy);
+            break;
+        }
+        case Op::MOVE_ASSIGN: {
+            Vector<T> other = MakeVector<T>(step.values);
+            v = std::move(other);
+            break;
+        }
+        case Op::SWAP: {
+            Vector<T> other = MakeVector<T>(step.values);
+            v.Swap(other);
+            break;
+        }
+        case Op::PARALLEL_COPY_FROM: {
+            const Vector<T> other = MakeVector<T>(step.values);
+            v.ParallelCopyFrom(other);
+            break;
+        }
+        case Op::PARALLEL_RESIZE:
+            v.ParallelResize(step.count);
+            break;
+        case Op::PARALLEL_CONSTRUCT: {
+            Vector<T> copy(PARALLEL, v);
+            v.Swap(copy);
+            break;
+        }
+        }
+    }
+
+    void ApplyModel(const Step& step, std::vector<int>& model) {
+        const auto pos = model.begin() + static_cast<std::ptrdiff_t>(step.pos);
+        switch (step.op) {
+        case Op::PUSH_BACK_COPY:
+        case Op::PUSH_BACK_MOVE:
+        case Op::EMPLACE_BACK:
+            model.push_back(step.value);
+            break;
+        case Op::EMPLACE:
+        case Op::INSERT_COPY:
+        case Op::INSERT_MOVE:
+            model.insert(pos, step.value);
+            break;
+        case Op::INSERT_FILL:
+            model.insert(pos, step.count, step.value);
+            break;
+        case Op::INSERT_RANGE:
+        case Op::INSERT_INPUT_RANGE:
+            model.insert(pos, step.values.begin(), step.values.end());
+            break;
+        case Op::APPEND:
+            model.insert(model.end(), step.values.begin(), step.values.end());
+            break;
+        case Op::ASSIGN_RANGE:
+        case Op::COPY_ASSIGN:
+        case Op::MOVE_ASSIGN:
+        case Op::SWAP:
+        case Op::PARALLEL_COPY_FROM:
+            model = step.values;
+            break;
+        case Op::ASSIGN_FILL:
+            model.assign(step.count, step.value);
+            break;
+        case Op::ERASE:
+            model.erase(pos);
+            break;
+        case Op::ERASE_RANGE:
+            model.erase(pos, pos + static_cast<std::ptrdiff_t>(step.count));
+            break;
+        case Op::ERASE_IF:
+            model.erase(std::remove_if(model.begin(), model.end(), [&step](int value) {
+                return EraseIfPredicate(value, step);
+                }), model.end());
+            break;
+        case Op::POP_BACK:
+            model.pop_back();
+            break;
+        case Op::RESIZE:
+        case Op::PARALLEL_RESIZE:
+            model.resize(step.count);
+            break;
+        case Op::CLEAR:
+            model.clear();
+            break;
+        case Op::RESERVE:
+        case Op::SHRINK_TO_FIT:
+        case Op::COPY_CONSTRUCT:
+        case Op::PARALLEL_CONSTRUCT:
+            break;
+        }
+    }
+
+    // Даёт ли операция над вектором before строгую гарантию. Иначе гарантия базовая: элементы
+    // могут измениться, но остаются живыми. Классификация повторяет устройство Vector: сдвиг
+    // элементов присваиванием в пределах буфера откатить нельзя, а переаллокация и сдвиг memmove
+    // откатываются
+    template <typename T>
+    bool IsStrong(const Step& step, const Vector<T>& before) {
+        constexpr bool RELOCATABLE = IsTriviallyRelocatableV<T>;
+        constexpr bool NOTHROW_MOVE = std::is_nothrow_move_constructible_v<T>;
+        const size_t size = before.Size();
+        const size_t capacity = before.Capacity();
+        switch (step.op) {
+        case Op::EMPLACE:
+        case Op::INSERT_COPY:
+        case Op::INSERT_MOVE:
+            return step.pos == size || size == capacity || RELOCATABLE || NOTHROW_MOVE;
+        case Op::INSERT_FILL:
+        case Op::INSERT_RANGE:
+        case Op::INSERT_INPUT_RANGE: {
+            const size_t count = step.op == Op::INSERT_FILL ? step.count : step.values.size();
+            return count == 0 || step.pos == size || size + count > capacity || RELOCATABLE;
+        }
+        case Op::ASSIGN_RANGE:
+            return step.values.size() > capacity;
+        case Op::ASSIGN_FILL:
+            return step.count > capacity;
+        case Op::COPY_ASSIGN:
+            return step.values.size() > capacity;
+        case Op::ERASE:
+        case Op::ERASE_RANGE:
+        case Op::ERASE_IF:
+            return NOTHROW_MOVE;
+        default:
+            return true;
+        }
+    }
+
+    template <typename T>
+    std::vector<int> Values(const Vector<T>& v) {
+        std::vector<int> values;
+        values.reserve(v.Size());
+        for (size_t i = 0; i < v.Size(); ++i) {
+            Require(v[i].IsAlive(), "dead element inside Vector");
+            values.push_back(v[i].Value());
+        }
+        return values;
+    }
+
+    // Копия вектора с той же ёмкостью, чтобы операции шли по тем же веткам
+    template <typename T>
+    Vector<T> CloneWithCapacity(const Vector<T>& v) {
+        Vector<T> clone;
+        clone.Reserve(v.Capacity());
+        clone.Append(v.begin(), v.end());
+        return clone;
+    }
+
+    // Выполняет шаг над копией v, выбрасывая исключение на событии inject (0 — без исключений).
+    // Возвращает число событий операции
+    template <typename T>
+    int64_t RunTrial(const Step& step, const Vector<T>& v, const std::vector<int>& before, const std::vector<int>& expected,
+        int64_t inject, Totals& totals) {
+        Vector<T> trial = CloneWithCapacity(v);
+        const int64_t baseline = Injection::live.load() - static_cast<int64_t>(trial.Size());
+        const bool strong = IsStrong(step, trial);
+        Injection::events = 0;
+        Injection::countdown = inject;
+        bool threw = false;
+        try {
+            Apply(step, trial);
+        }
+        catch (const InjectedError&) {
+            threw = true;
+        }
+        Injection::countdown = 0;
+        const int64_t events = Injection::events.load();
+        ++totals.trials;
+        Require(trial.Size() <= trial.Capacity(), "size exceeds capacity");
+        Require(Injection::live.load() == baseline + static_cast<int64_t>(trial.Size()), "element leaked or destroyed twice");
+        const std::vector<int> values = Values(trial);
+        if (!threw) {
+            Require(values == expected, "result differs from std::vector");
+        }
+        else if (strong) {
+            ++totals.strong_checks;
+            Require(values == before, "strong guarantee violated");
+        }
+        else {
+            ++totals.basic_checks;
+        }
+        return events;
+    }
+
+    template <typename T>
+    void FuzzType(std::string_view name, const Options& options, std::mt19937_64& random) {
+        Totals totals;
+        const uint64_t thrown_before = Injection::thrown.load();
+        int next_value = 1;
+        {
+            Vector<T> v;
+            std::vector<int> model;
+            for (size_t i = 0; i < options.steps; ++i) {
+                const Step step = MakeStep(random, model.size(), next_value);
+                Context() = std::string(name) + ", seed " + std::to_string(options.seed) + ", step " + std::to_string(i) + ", "
+                    + std::string(OP_NAMES[static_cast<size_t>(step.op)]) + ", size " + std::to_string(model.size())
+                    + ", capacity " + std::to_string(v.Capacity()) + ", pos " + std::to_string(step.pos)
+                    + ", count " + std::to_string(step.count) + ", range " + std::to_string(step.values.size());
+                std::vector<int> expected = model;
+                ApplyModel(step, expected);
+
+                const int64_t events = RunTrial(step, v, model, expected, 0, totals);
+                if (events <= static_cast<int64_t>(MAX_SIZE)) {
+                    for (int64_t inject = 1; inject <= events; ++inject) {
+                        RunTrial(step, v, model, expected, inject, totals);
+                    }
+                }
+                else {
+                    for (size_t j = 0; j < SAMPLED_INJECTIONS; ++j) {
+                        const int64_t inject = static_cast<int64_t>(Uniform(random, 1, static_cast<size_t>(events)));
+                        RunTrial(step, v, model, expected, inject, totals);
+                    }
+                }
+
+                Apply(step, v);
+                model = std::move(expected);
+                Require(Values(v) == model, "result differs from std::vector");
+            }
+        }
+        Context() = std::string(name) + ", after all steps";
+        Require(Injection::live.load() == 0, "elements leaked");
+        std::cout << name << ": " << options.steps << " steps, " << totals.trials << " trials, "
+            << Injection::thrown.load() - thrown_before << " injected exceptions, " << totals.strong_checks
+            << " strong and " << totals.basic_checks << " basic guarantee checks" << std::endl;
+    }
+
+    Options ParseOptions(int argc, char* argv[]) {
+        Options options;
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            const auto value = [&arg](std::string_view prefix) {
+                return std::string(arg.substr(prefix.size()));
+            };
+            if (arg.substr(0, 7) == "--seed=") {
+                options.seed = std::stoull(value("--seed="));
+            }
+            else if (arg.substr(0, 8) == "--steps=") {
+                options.steps = std::stoull(value("--steps="));
+            }
+            else if (arg.substr(0, 7) == "--type=") {
+                options.type = value("--type=");
+            }
+            else {
+                throw std::invalid_argument("Unknown option: " + std::string(arg));
+            }
+        }
+        return options;
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        const Options options = ParseOptions(argc, argv);
+        // Параллельные операции делят работу между потоками и на одноядерной машине
+        SetParallelThreadLimit(4);
+        std::mt19937_64 random(options.seed);
+        if (options.type.empty() || options.type == "may_throw") {
+            FuzzType<Tracked<MoveKind::MAY_THROW>>("may_throw", options, random);
+        }
+        if (options.type.empty() || options.type == "nothrow_move") {
+            FuzzType<Tracked<MoveKind::NOTHROW>>("nothrow_move", options, random);
+        }
+        if (options.type.empty() || options.type == "relocatable") {
+            FuzzType<Tracked<MoveKind::RELOCATABLE>>("relocatable", options, random);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
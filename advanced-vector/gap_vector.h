@@ -0,0 +1,554 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+//        ,    .
+//       .      
+// ,           
+//   ,    .   , 
+//   . Compact()     Vector.
+//        
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+class GapVector {
+    template <bool IsConst>
+    class Iterator {
+        using Container = std::conditional_t<IsConst, const GapVector, GapVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        Iterator() noexcept = default;
+        Iterator(Container* container, size_t index) noexcept
+            : container_(container)
+            , index_(index)  //
+        {
+        }
+        //     
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) noexcept
+            : container_(other.container_)
+            , index_(other.index_)  //
+        {
+        }
+
+        reference operator*() const noexcept {
+            return (*container_)[index_];
+        }
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        Iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++index_;
+            return old;
+        }
+        Iterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --index_;
+            return old;
+        }
+        Iterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+        Iterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+        friend Iterator operator+(Iterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+        friend Iterator operator+(difference_type offset, Iterator it) noexcept {
+            return it += offset;
+        }
+        friend Iterator operator-(Iterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+        friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+        friend bool operator>(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+        friend bool operator<=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+        friend bool operator>=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+    private:
+        template <bool>
+        friend class Iterator;
+
+        Container* container_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using allocator_type = Allocator;
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    GapVector() = default;
+    explicit GapVector(const Allocator& alloc) noexcept;
+
+    GapVector(const GapVector& other);
+    GapVector& operator=(const GapVector& rhs);
+
+    GapVector(GapVector&& other) noexcept;
+    GapVector& operator=(GapVector&& rhs) noexcept;
+
+    //     
+    void Swap(GapVector& other) noexcept;
+
+    Allocator GetAllocator() const noexcept;
+
+    size_t Size() const noexcept;
+    size_t Capacity() const noexcept;
+    //  ,    
+    size_t GapPosition() const noexcept;
+
+    void Reserve(size_t new_capacity);
+    void Clear() noexcept;
+
+    //     index,         
+    void MoveGap(size_t index);
+
+    void PushBack(const T& value);
+    void PushBack(T&& value);
+    void PopBack() /* noexcept */;
+    void Insert(size_t index, const T& value);
+    void Insert(size_t index, T&& value);
+    void Erase(size_t index);
+    void Erase(size_t first, size_t last);
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+    template <typename... Args>
+    T& Emplace(size_t index, Args&&... args);
+
+    //   
+    Vector<T, Allocator, GrowthPolicy> Compact() const&;
+    //     ;    
+    Vector<T, Allocator, GrowthPolicy> Compact() &&;
+
+    const T& operator[](size_t index) const noexcept;
+    T& operator[](size_t index) noexcept;
+
+    ~GapVector();
+
+private:
+    size_t GapSize() const noexcept;
+
+    //      new_capacity,   
+    void Reallocate(size_t new_capacity);
+
+    //       
+    void DestroyAll() noexcept;
+
+private:
+    RawMemory<T, Allocator> data_;
+    size_t gap_begin_ = 0;
+    size_t gap_end_ = 0;
+};
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename GapVector<T, Allocator, GrowthPolicy>::iterator GapVector<T, Allocator, GrowthPolicy>::begin() noexcept
+{
+    return iterator(this, 0);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename GapVector<T, Allocator, GrowthPolicy>::iterator GapVector<T, Allocator, GrowthPolicy>::end() noexcept
+{
+    return iterator(this, Size());
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename GapVector<T, Allocator, GrowthPolicy>::const_iterator GapVector<T, Allocator, GrowthPolicy>::begin() const noexcept
+{
+    return const_iterator(this, 0);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename GapVector<T, Allocator, GrowthPolicy>::const_iterator GapVector<T, Allocator, GrowthPolicy>::end() const noexcept
+{
+    return const_iterator(this, Size());
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename GapVector<T, Allocator, GrowthPolicy>::const_iterator GapVector<T, Allocator, GrowthPolicy>::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename GapVector<T, Allocator, GrowthPolicy>::const_iterator GapVector<T, Allocator, GrowthPolicy>::cend() const noexcept
+{
+    return end();
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline GapVector<T, Allocator, GrowthPolicy>::GapVector(const Allocator& alloc) noexcept
+    : data_(alloc)
+{
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline GapVector<T, Allocator, GrowthPolicy>::GapVector(const GapVector& other)
+    : data_(other.Size(), std::allocator_traits<Allocator>::select_on_container_copy_construction(other.data_.GetAllocator()))
+{
+    //      
+    std::uninitialized_copy_n(other.data_.GetAddress(), other.gap_begin_, data_.GetAddress());
+    try
+    {
+        std::uninitialized_copy_n(other.data_ + other.gap_end_, other.data_.Capacity() - other.gap_end_, data_ + other.gap_begin_);
+    }
+    catch (...)
+    {
+        std::destroy_n(data_.GetAddress(), other.gap_begin_);
+        throw;
+    }
+    gap_begin_ = other.Size();
+    gap_end_ = data_.Capacity();
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline GapVector<T, Allocator, GrowthPolicy>& GapVector<T, Allocator, GrowthPolicy>::operator=(const GapVector& rhs)
+{
+    if (this != &rhs)
+    {
+        GapVector rhs_copy(rhs);
+        Swap(rhs_copy);
+    }
+    return *this;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline GapVector<T, Allocator, GrowthPolicy>::GapVector(GapVector&& other) noexcept
+    : data_(std::move(other.data_))
+    , gap_begin_(std::exchange(other.gap_begin_, 0))
+    , gap_end_(std::exchange(other.gap_end_, 0))
+{
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline GapVector<T, Allocator, GrowthPolicy>& GapVector<T, Allocator, GrowthPolicy>::operator=(GapVector&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        GapVector rhs_moved(std::move(rhs));
+        Swap(rhs_moved);
+    }
+    return *this;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void GapVector<T, Allocator, GrowthPolicy>::Swap(GapVector& other) noexcept
+{
+    data_.Swap(other.data_);
+    std::swap(gap_begin_, other.gap_begin_);
+    std::swap(gap_end_, other.gap_end_);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Allocator GapVector<T, Allocator, GrowthPolicy>::GetAllocator() const noexcept
+{
+    return data_.GetAllocator();
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline size_t GapVector<T, Allocator, GrowthPolicy>::Size() const noexcept
+{
+    return data_.Capacity() - GapSize();
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline size_t GapVector<T, Allocator, GrowthPolicy>::Capacity() const noexcept
+{
+    return data_.Capacity();
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline size_t GapVector<T, Allocator, GrowthPolicy>::GapPosition() const noexcept
+{
+    return gap_begin_;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void GapVector<T, Allocator, GrowthPolicy>::Reserve(size_t new_capacity)
+{
+    if (new_capacity > data_.Capacity())
+    {
+        Reallocate(new_capacity);
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void GapVector<T, Allocator, GrowthPolicy>::Clear() noexcept
+{
+    DestroyAll();
+    gap_begin_ = 0;
+    gap_end_ = data_.Capacity();
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void GapVector<T, Allocator, GrowthPolicy>::MoveGap(size_t index)
+{
+    assert(index <= Size());
+    if (GapSize() == 0)
+    {
+        //      
+        gap_begin_ = gap_end_ = index;
+        return;
+    }
+    if constexpr (IsTriviallyRelocatableV<T>)
+    {
+        if (index < gap_begin_)
+        {
+            const size_t count = gap_begin_ - index;
+            std::memmove(static_cast<void*>(data_ + (gap_end_ - count)), static_cast<const void*>(data_ + index), count * sizeof(T));
+            gap_begin_ -= count;
+            gap_end_ -= count;
+        }
+        else if (index > gap_begin_)
+        {
+            const size_t count = index - gap_begin_;
+            std::memmove(static_cast<void*>(data_ + gap_begin_), static_cast<const void*>(data_ + gap_end_), count * sizeof(T));
+            gap_begin_ += count;
+            gap_end_ += count;
+        }
+    }
+    else
+    {
+        //      ,     
+        //  ,    ,   
+        while (index < gap_begin_)
+        {
+            new (data_ + (gap_end_ - 1)) T(std::move_if_noexcept(data_[gap_begin_ - 1]));
+            std::destroy_at(data_ + (gap_begin_ - 1));
+            --gap_begin_;
+            --gap_end_;
+        }
+        while (index > gap_begin_)
+        {
+            new (data_ + gap_begin_) T(std::move_if_noexcept(data_[gap_end_]));
+            std::destroy_at(data_ + gap_end_);
+            ++gap_begin_;
+            ++gap_end_;
+        }
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void GapVector<T, Allocator, GrowthPolicy>::PushBack(const T& value)
+{
+    Emplace(Size(), value);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void GapVector<T, Allocator, GrowthPolicy>::PushBack(T&& value)
+{
+    Emplace(Size(), std::move(value));
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void GapVector<T, Allocator, GrowthPolicy>::PopBack()
+{
+    assert(Size() > 0);
+    Erase(Size() - 1);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void GapVector<T, Allocator, GrowthPolicy>::Insert(size_t index, const T& value)
+{
+    Emplace(index, value);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void GapVector<T, Allocator, GrowthPolicy>::Insert(size_t index, T&& value)
+{
+    Emplace(index, std::move(value));
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void GapVector<T, Allocator, GrowthPolicy>::Erase(size_t index)
+{
+    Erase(index, index + 1);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void GapVector<T, Allocator, GrowthPolicy>::Erase(size_t first, size_t last)
+{
+    assert(first <= last && last <= Size());
+    if (first == last)
+    {
+        return;
+    }
+    if (last <= gap_begin_)
+    {
+        //          
+        MoveGap(last);
+        std::destroy_n(data_ + first, last - first);
+        gap_begin_ = first;
+    }
+    else if (first >= gap_begin_)
+    {
+        MoveGap(first);
+        std::destroy_n(data_ + gap_end_, last - first);
+        gap_end_ += last - first;
+    }
+    else
+    {
+        //    :   
+        const size_t after = last - gap_begin_;
+        std::destroy_n(data_ + first, gap_begin_ - first);
+        std::destroy_n(data_ + gap_end_, after);
+        gap_begin_ = first;
+        gap_end_ += after;
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename... Args>
+inline T& GapVector<T, Allocator, GrowthPolicy>::EmplaceBack(Args&&... args)
+{
+    return Emplace(Size(), std::forward<Args>(args)...);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename... Args>
+inline T& GapVector<T, Allocator, GrowthPolicy>::Emplace(size_t index, Args&&... args)
+{
+    assert(index <= Size());
+    if (detail::AnyArgumentInRange(data_.GetAddress(), data_.GetAddress() + data_.Capacity(), args...))
+    {
+        //    ,       
+        return Emplace(index, T(std::forward<Args>(args)...));
+    }
+    MoveGap(index);
+    if (GapSize() == 0)
+    {
+        Reallocate(GrowthPolicy::NextCapacity(data_.Capacity(), data_.Capacity() + 1, sizeof(T)));
+    }
+    T* elem = new (data_ + gap_begin_) T(std::forward<Args>(args)...);
+    ++gap_begin_;
+    return *elem;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy> GapVector<T, Allocator, GrowthPolicy>::Compact() const&
+{
+    Vector<T, Allocator, GrowthPolicy> result(data_.GetAllocator());
+    result.Reserve(Size());
+    result.Append(data_.GetAddress(), data_ + gap_begin_);
+    result.Append(data_ + gap_end_, data_ + data_.Capacity());
+    return result;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy> GapVector<T, Allocator, GrowthPolicy>::Compact() &&
+{
+    Vector<T, Allocator, GrowthPolicy> result(data_.GetAllocator());
+    result.Reserve(Size());
+    result.Append(std::make_move_iterator(data_.GetAddress()), std::make_move_iterator(data_ + gap_begin_));
+    result.Append(std::make_move_iterator(data_ + gap_end_), std::make_move_iterator(data_ + data_.Capacity()));
+    Clear();
+    return result;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline const T& GapVector<T, Allocator, GrowthPolicy>::operator[](size_t index) const noexcept
+{
+    return const_cast<GapVector&>(*this)[index];
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline T& GapVector<T, Allocator, GrowthPolicy>::operator[](size_t index) noexcept
+{
+    assert(index < Size());
+    return data_[index < gap_begin_ ? index : index + GapSize()];
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline GapVector<T, Allocator, GrowthPolicy>::~GapVector()
+{
+    DestroyAll();
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline size_t GapVector<T, Allocator, GrowthPolicy>::GapSize() const noexcept
+{
+    return gap_end_ - gap_begin_;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void GapVector<T, Allocator, GrowthPolicy>::Reallocate(size_t new_capacity)
+{
+    RawMemory<T, Allocator> new_data(new_capacity, data_.GetAllocator());
+    const size_t tail = data_.Capacity() - gap_end_;
+    const size_t new_gap_end = new_data.Capacity() - tail;
+    detail::UninitializedRelocateN(data_.GetAddress(), gap_begin_, new_data.GetAddress());
+    try
+    {
+        detail::UninitializedRelocateN(data_ + gap_end_, tail, new_data + new_gap_end);
+    }
+    catch (...)
+    {
+        std::destroy_n(new_data.GetAddress(), gap_begin_);
+        throw;
+    }
+    detail::DestroyRelocatedN(data_.GetAddress(), gap_begin_);
+    detail::DestroyRelocatedN(data_ + gap_end_, tail);
+    instrumentation::OnReallocate<T>(data_.Capacity(), new_data.Capacity());
+    data_.Swap(new_data);
+    gap_end_ = new_gap_end;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void GapVector<T, Allocator, GrowthPolicy>::DestroyAll() noexcept
+{
+    std::destroy_n(data_.GetAddress(), gap_begin_);
+    std::destroy_n(data_ + gap_end_, data_.Capacity() - gap_end_);
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+//      ,      :
+//     static size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept;
+// capacity   , required     ( capacity),
+// element_size     .      required
+
+namespace detail {
+
+    //  ,        size_t
+    constexpr size_t MaxCapacity(size_t element_size) noexcept {
+        return std::numeric_limits<size_t>::max() / element_size;
+    }
+
+}  // namespace detail
+
+//  ,    
+struct DoublingGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t max_capacity = detail::MaxCapacity(element_size);
+        const size_t grown = capacity == 0 ? 1 : (capacity > max_capacity / 2 ? max_capacity : capacity * 2);
+        return std::max(grown, required);
+    }
+};
+
+//    :         
+// ,          
+struct OneAndHalfGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t max_capacity = detail::MaxCapacity(element_size);
+        const size_t grown = capacity < 2 ? capacity + 1
+            : (capacity > max_capacity / 3 * 2 ? max_capacity : capacity + capacity / 2);
+        return std::max(grown, required);
+    }
+};
+
+//      CacheLine ,    
+//     1, 2, 4... .     Base
+template <typename Base = DoublingGrowth, size_t CacheLine = 64>
+struct CacheLineMinimumGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t next = Base::NextCapacity(capacity, required, element_size);
+        if (capacity != 0) {
+            return next;
+        }
+        return std::max(next, (CacheLine + element_size - 1) / element_size);
+    }
+};
+
+//   Threshold        PageSize,  
+//   ,      
+template <typename Base = DoublingGrowth, size_t PageSize = 4096, size_t Threshold = 64 * 1024>
+struct PageRoundedGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t next = Base::NextCapacity(capacity, required, element_size);
+        if (next > detail::MaxCapacity(element_size) / 2) {
+            return next;
+        }
+        const size_t bytes = next * element_size;
+        if (bytes < Threshold) {
+            return next;
+        }
+        const size_t rounded = (bytes + PageSize - 1) / PageSize * PageSize;
+        return rounded / element_size;
+    }
+};
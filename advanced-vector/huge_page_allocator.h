@@ -0,0 +1,212 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+//     HugePageAllocator
+struct HugePageOptions {
+    //     (MAP_HUGETLB).      ,
+    //        (madvise(MADV_HUGEPAGE))
+    bool explicit_huge_pages = false;
+    //  NUMA,     ; -1   
+    int numa_node = -1;
+};
+
+//     .   Threshold    mmap
+//   ,    TLB       ,
+//   mremap      ,      .
+//   Threshold    .    mmap  
+//   
+template <typename T, size_t Threshold = size_t(2) << 20>
+class HugePageAllocator {
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = HugePageAllocator<U, Threshold>;
+    };
+
+    HugePageAllocator() noexcept = default;
+
+    explicit HugePageAllocator(HugePageOptions options) noexcept
+        : options_(options)  //
+    {
+    }
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U, Threshold>& other) noexcept
+        : options_(other.GetOptions())  //
+    {
+    }
+
+    T* allocate(size_t n) {
+        if (n > MAX_ELEMENTS) {
+            throw std::bad_array_new_length();
+        }
+        const size_t bytes = n * sizeof(T);
+        if (!IsMapped(bytes)) {
+            return static_cast<T*>(::operator new(bytes, std::align_val_t{ alignof(T) }));
+        }
+        return static_cast<T*>(Map(bytes));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (!IsMapped(bytes)) {
+            ::operator delete(static_cast<void*>(ptr), bytes, std::align_val_t{ alignof(T) });
+            return;
+        }
+#if defined(__linux__)
+        munmap(static_cast<void*>(ptr), MappedLength(bytes));
+#endif
+    }
+
+    //     :     
+    //   mremap,    
+    bool TryExpand(T* ptr, size_t old_n, size_t new_n) noexcept {
+        const size_t old_bytes = old_n * sizeof(T);
+        if (!IsMapped(old_bytes) || new_n > MAX_ELEMENTS) {
+            return false;
+        }
+        const size_t old_length = MappedLength(old_bytes);
+        const size_t new_length = MappedLength(new_n * sizeof(T));
+        if (new_length == old_length) {
+            return true;
+        }
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+        if (!options_.explicit_huge_pages && mremap(static_cast<void*>(ptr), old_length, new_length, 0) != MAP_FAILED) {
+            Advise(ptr, new_length);
+            return true;
+        }
+#else
+        (void)ptr;
+#endif
+        return false;
+    }
+
+    //  ,   .    
+    // mremap,     
+    T* Reallocate(T* ptr, size_t old_n, size_t new_n) {
+        const size_t old_bytes = old_n * sizeof(T);
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+        if (!options_.explicit_huge_pages && IsMapped(old_bytes) && new_n <= MAX_ELEMENTS && IsMapped(new_n * sizeof(T))) {
+            const size_t new_length = MappedLength(new_n * sizeof(T));
+            void* result = mremap(static_cast<void*>(ptr), MappedLength(old_bytes), new_length, MREMAP_MAYMOVE);
+            if (result == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            Advise(result, new_length);
+            return static_cast<T*>(result);
+        }
+#endif
+        T* result = allocate(new_n);
+        std::memcpy(static_cast<void*>(result), static_cast<const void*>(ptr), (old_n < new_n ? old_n : new_n) * sizeof(T));
+        deallocate(ptr, old_n);
+        return result;
+    }
+
+    const HugePageOptions& GetOptions() const noexcept {
+        return options_;
+    }
+
+    // ,   ,  ,    
+    template <typename U>
+    bool operator==(const HugePageAllocator<U, Threshold>& other) const noexcept {
+        return options_.explicit_huge_pages == other.GetOptions().explicit_huge_pages;
+    }
+
+    template <typename U>
+    bool operator!=(const HugePageAllocator<U, Threshold>& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    static constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+    //   ,      size_t
+    static constexpr size_t MAX_ELEMENTS = (static_cast<size_t>(-1) - HUGE_PAGE_SIZE) / sizeof(T);
+
+    static bool IsMapped(size_t bytes) noexcept {
+#if defined(__linux__)
+        return bytes >= Threshold && bytes != 0;
+#else
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    //  :   .       
+    //       ,  munmap    
+    size_t MappedLength(size_t bytes) const noexcept {
+        const size_t page = options_.explicit_huge_pages ? HUGE_PAGE_SIZE : PageSize();
+        return (bytes + page - 1) / page * page;
+    }
+
+    static size_t PageSize() noexcept {
+#if defined(__linux__)
+        static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return page_size;
+#else
+        return 4096;
+#endif
+    }
+
+    void* Map(size_t bytes) const {
+#if defined(__linux__)
+        const size_t length = MappedLength(bytes);
+        void* ptr = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+        if (options_.explicit_huge_pages) {
+            ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+#endif
+        if (ptr == MAP_FAILED) {
+            ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            Advise(ptr, length);
+        }
+        BindToNode(ptr, length);
+        return ptr;
+#else
+        (void)bytes;
+        throw std::bad_alloc();
+#endif
+    }
+
+    //         
+    static void Advise(void* ptr, size_t length) noexcept {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        madvise(ptr, length, MADV_HUGEPAGE);
+#else
+        (void)ptr;
+        (void)length;
+#endif
+    }
+
+    //         NUMA.    ,
+    //      .  :   
+    void BindToNode(void* ptr, size_t length) const noexcept {
+#if defined(__linux__) && defined(SYS_mbind)
+        constexpr int MPOL_PREFERRED_MODE = 1;
+        constexpr size_t MAX_NODES = sizeof(unsigned long) * 8;
+        if (options_.numa_node >= 0 && static_cast<size_t>(options_.numa_node) < MAX_NODES) {
+            const unsigned long node_mask = 1ul << options_.numa_node;
+            syscall(SYS_mbind, ptr, length, MPOL_PREFERRED_MODE, &node_mask, MAX_NODES, 0u);
+        }
+#else
+        (void)ptr;
+        (void)length;
+#endif
+    }
+
+    HugePageOptions options_;
+};
@@ -0,0 +1,252 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+//      .  
+// ADVANCED_VECTOR_INSTRUMENTATION;           .
+//        T.     
+//     ,  InstrumentationTag:
+//     struct HotTables { static constexpr const char* NAME = "hot_tables"; };
+//     template <> struct InstrumentationTag<Row> { using type = HotTables; };
+
+#if defined(ADVANCED_VECTOR_INSTRUMENTATION)
+inline constexpr bool INSTRUMENTATION_ENABLED = true;
+#else
+inline constexpr bool INSTRUMENTATION_ENABLED = false;
+#endif
+
+template <typename T>
+struct InstrumentationTag {
+    using type = T;
+};
+
+//      
+struct VectorStats {
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t bytes_allocated = 0;
+    //   :     ,   , realloc
+    uint64_t reallocations = 0;
+    uint64_t elements_relocated = 0;
+    // ,   ,       
+    uint64_t copy_fallback_relocations = 0;
+    uint64_t peak_capacity = 0;
+};
+
+namespace instrumentation {
+
+    class Counters {
+    public:
+        void OnAllocate(size_t capacity, size_t bytes) noexcept {
+            allocations_.fetch_add(1, std::memory_order_relaxed);
+            bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed);
+            UpdatePeak(capacity);
+        }
+
+        void OnDeallocate() noexcept {
+            deallocations_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void OnReallocate(size_t old_capacity, size_t new_capacity) noexcept {
+            if (old_capacity != 0) {
+                reallocations_.fetch_add(1, std::memory_order_relaxed);
+            }
+            UpdatePeak(new_capacity);
+        }
+
+        void OnRelocate(size_t count, bool copied) noexcept {
+            elements_relocated_.fetch_add(count, std::memory_order_relaxed);
+            if (copied) {
+                copy_fallback_relocations_.fetch_add(count, std::memory_order_relaxed);
+            }
+        }
+
+        VectorStats Snapshot() const noexcept {
+            VectorStats stats;
+            stats.allocations = allocations_.load(std::memory_order_relaxed);
+            stats.deallocations = deallocations_.load(std::memory_order_relaxed);
+            stats.bytes_allocated = bytes_allocated_.load(std::memory_order_relaxed);
+            stats.reallocations = reallocations_.load(std::memory_order_relaxed);
+            stats.elements_relocated = elements_relocated_.load(std::memory_order_relaxed);
+            stats.copy_fallback_relocations = copy_fallback_relocations_.load(std::memory_order_relaxed);
+            stats.peak_capacity = peak_capacity_.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+        void Reset() noexcept {
+            allocations_ = 0;
+            deallocations_ = 0;
+            bytes_allocated_ = 0;
+            reallocations_ = 0;
+            elements_relocated_ = 0;
+            copy_fallback_relocations_ = 0;
+            peak_capacity_ = 0;
+        }
+
+    private:
+        void UpdatePeak(uint64_t capacity) noexcept {
+            uint64_t peak = peak_capacity_.load(std::memory_order_relaxed);
+            while (capacity > peak && !peak_capacity_.compare_exchange_weak(peak, capacity, std::memory_order_relaxed)) {
+            }
+        }
+
+        std::atomic<uint64_t> allocations_{ 0 };
+        std::atomic<uint64_t> deallocations_{ 0 };
+        std::atomic<uint64_t> bytes_allocated_{ 0 };
+        std::atomic<uint64_t> reallocations_{ 0 };
+        std::atomic<uint64_t> elements_relocated_{ 0 };
+        std::atomic<uint64_t> copy_fallback_relocations_{ 0 };
+        std::atomic<uint64_t> peak_capacity_{ 0 };
+    };
+
+    //   ,   ,  
+    class Registry {
+    public:
+        static Registry& Instance() {
+            static Registry registry;
+            return registry;
+        }
+
+        void Add(std::string name, Counters* counters) {
+            std::lock_guard guard(mutex_);
+            entries_.emplace_back(std::move(name), counters);
+        }
+
+        std::vector<std::pair<std::string, VectorStats>> Snapshot() const {
+            std::lock_guard guard(mutex_);
+            std::vector<std::pair<std::string, VectorStats>> result;
+            result.reserve(entries_.size());
+            for (const auto& [name, counters] : entries_) {
+                result.emplace_back(name, counters->Snapshot());
+            }
+            return result;
+        }
+
+        void Reset() {
+            std::lock_guard guard(mutex_);
+            for (const auto& entry : entries_) {
+                entry.second->Reset();
+            }
+        }
+
+    private:
+        mutable std::mutex mutex_;
+        std::vector<std::pair<std::string, Counters*>> entries_;
+    };
+
+    template <typename Tag, typename = void>
+    struct TagName {
+        static std::string Get() {
+            return typeid(Tag).name();
+        }
+    };
+
+    template <typename Tag>
+    struct TagName<Tag, std::void_t<decltype(Tag::NAME)>> {
+        static std::string Get() {
+            return Tag::NAME;
+        }
+    };
+
+    //   Tag,      
+    template <typename Tag>
+    Counters& CountersFor() {
+        static Counters* counters = [] {
+            static Counters instance;
+            Registry::Instance().Add(TagName<Tag>::Get(), &instance);
+            return &instance;
+        }();
+        return *counters;
+    }
+
+    template <typename T>
+    Counters& CountersOf() {
+        return CountersFor<typename InstrumentationTag<std::remove_cv_t<T>>::type>();
+    }
+
+    template <typename T>
+    inline void OnAllocate(size_t capacity) noexcept {
+        if constexpr (INSTRUMENTATION_ENABLED) {
+            CountersOf<T>().OnAllocate(capacity, capacity * sizeof(T));
+        }
+    }
+
+    template <typename T>
+    inline void OnDeallocate() noexcept {
+        if constexpr (INSTRUMENTATION_ENABLED) {
+            CountersOf<T>().OnDeallocate();
+        }
+    }
+
+    //   old_capacity     new_capacity.  
+    // (old_capacity == 0)   
+    template <typename T>
+    inline void OnReallocate(size_t old_capacity, size_t new_capacity) noexcept {
+        if constexpr (INSTRUMENTATION_ENABLED) {
+            CountersOf<T>().OnReallocate(old_capacity, new_capacity);
+        }
+    }
+
+    template <typename T>
+    inline void OnRelocate(size_t count, bool copied) noexcept {
+        if constexpr (INSTRUMENTATION_ENABLED) {
+            CountersOf<T>().OnRelocate(count, copied);
+        }
+    }
+
+}  // namespace instrumentation
+
+//      T ( ,  T). 
+// ADVANCED_VECTOR_INSTRUMENTATION  
+template <typename T>
+VectorStats GetVectorStats() {
+    if constexpr (INSTRUMENTATION_ENABLED) {
+        return instrumentation::CountersOf<T>().Snapshot();
+    }
+    else {
+        return {};
+    }
+}
+
+//      ,    
+inline std::vector<std::pair<std::string, VectorStats>> SnapshotVectorStats() {
+    return instrumentation::Registry::Instance().Snapshot();
+}
+
+inline void ResetVectorStats() {
+    instrumentation::Registry::Instance().Reset();
+}
+
+//     CSV  
+inline void ExportVectorStatsCsv(std::ostream& out) {
+    out << "tag,allocations,deallocations,bytes_allocated,reallocations,elements_relocated,"
+        "copy_fallback_relocations,peak_capacity\n";
+    for (const auto& [name, stats] : SnapshotVectorStats()) {
+        out << name << ',' << stats.allocations << ',' << stats.deallocations << ',' << stats.bytes_allocated << ','
+            << stats.reallocations << ',' << stats.elements_relocated << ',' << stats.copy_fallback_relocations << ','
+            << stats.peak_capacity << '\n';
+    }
+}
+
+//     JSON:  ,      
+inline void ExportVectorStatsJson(std::ostream& out) {
+    out << '[';
+    bool first = true;
+    for (const auto& [name, stats] : SnapshotVectorStats()) {
+        out << (first ? "" : ",") << "{\"tag\":\"" << name << "\",\"allocations\":" << stats.allocations
+            << ",\"deallocations\":" << stats.deallocations << ",\"bytes_allocated\":" << stats.bytes_allocated
+            << ",\"reallocations\":" << stats.reallocations << ",\"elements_relocated\":" << stats.elements_relocated
+            << ",\"copy_fallback_relocations\":" << stats.copy_fallback_relocations
+            << ",\"peak_capacity\":" << stats.peak_capacity << '}';
+        first = false;
+    }
+    out << "]\n";
+}
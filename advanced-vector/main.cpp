@@ -1,10 +1,39 @@
 ﻿#include "vector.h"
+#include "allocators.h"
+#include "small_vector.h"
+#include "huge_page_allocator.h"
+#include "mapped_vector.h"
+#include "serialization.h"
+#include "segmented_vector.h"
+#include "concurrent_vector.h"
+#include "static_vector.h"
+#include "gap_vector.h"
+#include "soa_vector.h"
+#include "flat_map.h"
+#include "parallel_algorithms.h"
 
 #include <iostream>
 #include <stdexcept>
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <limits>
+#include <list>
+#include <map>
+#include <set>
+#include <sstream>
+#include <atomic>
+#include <thread>
+#include <random>
+#include <numeric>
+#include <filesystem>
+#include <csignal>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 namespace {
 
@@ -117,8 +146,209 @@ namespace {
         static inline int num_move_assigned = 0;
     };
 
+    // Владеющий указатель, который можно переносить побайтово
+    struct Handle {
+        Handle() = default;
+        explicit Handle(int value)
+            : ptr(new int(value))  //
+        {
+        }
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+        Handle(Handle&& other) noexcept
+            : ptr(std::exchange(other.ptr, nullptr))  //
+        {
+            ++num_moved;
+        }
+        Handle& operator=(Handle&& other) noexcept {
+            std::swap(ptr, other.ptr);
+            return *this;
+        }
+        ~Handle() {
+            delete ptr;
+        }
+
+        int* ptr = nullptr;
+
+        static inline int num_moved = 0;
+    };
+
+    // Перемещение не помечено noexcept, поэтому при переносе элементы копируются
+    struct MayThrowOnMove {
+        explicit MayThrowOnMove(int value)
+            : value(value)  //
+        {
+        }
+        MayThrowOnMove(const MayThrowOnMove&) = default;
+        MayThrowOnMove(MayThrowOnMove&& other)
+            : value(other.value)  //
+        {
+        }
+        MayThrowOnMove& operator=(const MayThrowOnMove&) = default;
+        ~MayThrowOnMove() {
+        }
+
+        int value = 0;
+    };
+
+    // Объект с потокобезопасным счётчиком живых экземпляров для проверки параллельных операций
+    struct Counted {
+        Counted() {
+            ++alive;
+        }
+        Counted(const Counted& other)
+            : value(other.value)  //
+        {
+            if (value == THROW_ON_COPY) {
+                throw std::runtime_error("Oops");
+            }
+            ++alive;
+        }
+        Counted& operator=(const Counted&) = default;
+        ~Counted() {
+            --alive;
+        }
+
+        static constexpr int THROW_ON_COPY = -1;
+        int value = 0;
+
+        static inline std::atomic<int> alive{ 0 };
+    };
+
+    struct StatsTag {
+        static constexpr const char* NAME = "stats_tag";
+    };
+
+    // Тривиально копируемый тип, конструктор которого может выбросить исключение
+    struct Checked {
+        explicit Checked(int value)
+            : value(value)  //
+        {
+            if (value < 0) {
+                throw std::invalid_argument("Negative value");
+            }
+        }
+
+        int value;
+    };
+
+    // Тип, присваивание которого выбрасывает исключение для значения Counted::THROW_ON_COPY
+    struct ThrowingAssign {
+        explicit ThrowingAssign(int value)
+            : value(value)  //
+        {
+            ++alive;
+        }
+        ThrowingAssign(const ThrowingAssign& other)
+            : value(other.value)  //
+        {
+            ++alive;
+        }
+        ThrowingAssign& operator=(const ThrowingAssign& rhs) {
+            if (rhs.value == Counted::THROW_ON_COPY) {
+                throw std::runtime_error("Oops");
+            }
+            value = rhs.value;
+            return *this;
+        }
+        ~ThrowingAssign() {
+            --alive;
+        }
+
+        int value;
+        static inline int alive = 0;
+    };
+
+    // Аллокатор поверх std::allocator, считающий выделения всех своих экземпляров независимо от T
+    struct AllocationCounter {
+        static inline int allocations = 0;
+    };
+
+    template <typename T>
+    struct CountingAllocator {
+        using value_type = T;
+
+        CountingAllocator() noexcept = default;
+
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U>& /*other*/) noexcept {
+        }
+
+        T* allocate(size_t n) {
+            ++AllocationCounter::allocations;
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* ptr, size_t n) noexcept {
+            std::allocator<T>().deallocate(ptr, n);
+        }
+
+        template <typename U>
+        bool operator==(const CountingAllocator<U>& /*other*/) const noexcept {
+            return true;
+        }
+
+        template <typename U>
+        bool operator!=(const CountingAllocator<U>& /*other*/) const noexcept {
+            return false;
+        }
+    };
+
+    // Значение, копирование которого выбрасывает исключение, когда исчерпан счётчик copies_left.
+    // Конструктора перемещения нет, поэтому перемещение тоже копирует и может выбросить исключение
+    struct CopyCountdown {
+        explicit CopyCountdown(int value)
+            : value(value)  //
+        {
+        }
+        CopyCountdown(const CopyCountdown& other)
+            : value(other.value)  //
+        {
+            if (copies_left-- == 0) {
+                throw std::runtime_error("Oops");
+            }
+        }
+        CopyCountdown& operator=(const CopyCountdown&) = default;
+
+        int value;
+        // Отрицательное значение отключает исключения
+        static inline int copies_left = -1;
+    };
+
+    constexpr int StaticVectorSum() {
+        StaticVector<int, 8> v{};
+        for (int i = 1; i <= 5; ++i) {
+            v.PushBack(i);
+        }
+        v.Emplace(v.begin(), 10);
+        v.Insert(v.begin() + 3, 20);
+        v.Erase(v.begin() + 1);
+        v.PopBack();
+        StaticVector<int, 8> copy = v;
+        copy.Resize(7);
+        // 10, 2, 20, 3, 4, 0, 0
+        int sum = 0;
+        for (int value : copy) {
+            sum = sum * 2 + value;
+        }
+        return sum + static_cast<int>(copy.Size()) * 1000;
+    }
+
 }  // namespace
 
+template <>
+struct IsTriviallyRelocatable<Handle> : std::true_type {
+};
+
+template <>
+struct ParallelRelocation<Counted> : std::true_type {
+};
+
+template <>
+struct InstrumentationTag<MayThrowOnMove> {
+    using type = StatsTag;
+};
+
 void Test1() {
     Obj::ResetCounters();
     const size_t SIZE = 100500;
@@ -438,7 +668,7 @@ void Test6() {
     {
         Obj::ResetCounters();
         Vector<Obj> v;
-        auto* pos = v.Emplace(v.end(), Obj{ 1 });
+        auto pos = v.Emplace(v.end(), Obj{ 1 });
         assert(v.Size() == 1);
         assert(v.Capacity() >= v.Size());
         assert(&*pos == &v[0]);
@@ -453,7 +683,7 @@ void Test6() {
         Obj::ResetCounters();
         Vector<Obj> v;
         v.Reserve(SIZE);
-        auto* pos = v.Emplace(v.end(), Obj{ 1 });
+        auto pos = v.Emplace(v.end(), Obj{ 1 });
         assert(v.Size() == 1);
         assert(v.Capacity() >= v.Size());
         assert(&*pos == &v[0]);
@@ -500,7 +730,7 @@ void Test6() {
     {
         Obj::ResetCounters();
         Vector<Obj> v{ SIZE };
-        auto* pos = v.Emplace(v.cbegin() + 1, ID, "Ivan"s);
+        auto pos = v.Emplace(v.cbegin() + 1, ID, "Ivan"s);
         assert(v.Size() == SIZE + 1);
         assert(v.Capacity() == SIZE * 2);
         assert(&*pos == &v[1]);
@@ -516,7 +746,7 @@ void Test6() {
     {
         Obj::ResetCounters();
         Vector<Obj> v{ SIZE };
-        auto* pos = v.Emplace(v.cbegin() + v.Size(), ID, "Ivan"s);
+        auto pos = v.Emplace(v.cbegin() + v.Size(), ID, "Ivan"s);
         assert(v.Size() == SIZE + 1);
         assert(v.Capacity() == SIZE * 2);
         assert(&*pos == &v[SIZE]);
@@ -535,7 +765,7 @@ void Test6() {
         v.Reserve(SIZE * 2);
         const int old_num_moved = Obj::num_moved;
         assert(v.Capacity() == SIZE * 2);
-        auto* pos = v.Emplace(v.cbegin() + 3, ID, "Ivan"s);
+        auto pos = v.Emplace(v.cbegin() + 3, ID, "Ivan"s);
         assert(v.Size() == SIZE + 1);
         assert(&*pos == &v[3]);
         assert(v[3].id == ID);
@@ -551,7 +781,7 @@ void Test6() {
         Obj::ResetCounters();
         Vector<Obj> v{ SIZE };
         v[2].id = ID;
-        auto* pos = v.Erase(v.cbegin() + 1);
+        auto pos = v.Erase(v.cbegin() + 1);
         assert((pos - v.begin()) == 1);
         assert(v.Size() == SIZE - 1);
         assert(v.Capacity() == SIZE);
@@ -564,87 +794,2101 @@ void Test6() {
     }
 }
 
-struct C {
-    C() noexcept {
-        ++def_ctor;
+void Test7() {
+    const size_t SIZE = 1000;
+    {
+        Vector<int> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        v.Insert(v.cbegin() + SIZE / 2, -1);
+        v.Reserve(SIZE * 4);
+        assert(v.Size() == SIZE + 1);
+        assert(v[SIZE / 2] == -1);
+        assert(v[SIZE / 2 - 1] == static_cast<int>(SIZE / 2 - 1));
+        assert(v[SIZE] == static_cast<int>(SIZE - 1));
+    }
+    {
+        Handle::num_moved = 0;
+        Vector<Handle> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        // Тривиально перемещаемые элементы переносятся без вызова конструктора перемещения
+        assert(Handle::num_moved == 0);
+        v.Emplace(v.cbegin(), -1);
+        Handle::num_moved = 0;
+        v.Reserve(SIZE * 4);
+        assert(Handle::num_moved == 0);
+        assert(*v[0].ptr == -1);
+        assert(*v[SIZE].ptr == static_cast<int>(SIZE - 1));
+    }
+    Obj::ResetCounters();
+    {
+        struct ThrowingMove {
+            ThrowingMove() = default;
+            ThrowingMove(const ThrowingMove& other)
+                : obj(other.obj) {
+            }
+            ThrowingMove(ThrowingMove&& other)
+                : obj(other.obj) {
+            }
+            ThrowingMove& operator=(const ThrowingMove&) = default;
+            ThrowingMove& operator=(ThrowingMove&&) = default;
+            Obj obj;
+        };
+        Vector<ThrowingMove> v(SIZE);
+        v[SIZE - 1].obj.throw_on_copy = true;
+        try {
+            v.EmplaceBack();
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() == SIZE);
+        assert(Obj::GetAliveObjectCount() == SIZE);
+        try {
+            v.Emplace(v.cbegin() + 1);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == SIZE);
+        assert(Obj::GetAliveObjectCount() == SIZE);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test8() {
+    const size_t SIZE = 1000;
+    using namespace std::literals;
+    {
+        MonotonicArena arena;
+        {
+            Vector<int, ArenaAllocator<int>> v{ ArenaAllocator<int>(arena) };
+            for (size_t i = 0; i < SIZE; ++i) {
+                v.PushBack(static_cast<int>(i));
+            }
+            assert(arena.BytesAllocated() >= SIZE * sizeof(int));
+            auto v_copy(v);
+            assert(v_copy.GetAllocator() == v.GetAllocator());
+            assert(v_copy[SIZE - 1] == static_cast<int>(SIZE - 1));
+            auto v_moved(std::move(v_copy));
+            assert(v_moved.Size() == SIZE);
+            assert(v_moved.GetAllocator().GetResource() == &arena);
+        }
+        arena.Release();
+        assert(arena.BytesAllocated() == 0);
+    }
+    Obj::ResetCounters();
+    {
+        MonotonicArena arena1;
+        MonotonicArena arena2;
+        Vector<Obj, ArenaAllocator<Obj>> v1(SIZE, ArenaAllocator<Obj>(arena1));
+        Vector<Obj, ArenaAllocator<Obj>> v2{ ArenaAllocator<Obj>(arena2) };
+        v1[0].id = 42;
+        // Аллокатор не распространяется при перемещении, поэтому элементы перемещаются по одному
+        v2 = std::move(v1);
+        assert(v2.GetAllocator().GetResource() == &arena2);
+        assert(v2.Size() == SIZE);
+        assert(v2[0].id == 42);
+        assert(Obj::num_moved == static_cast<int>(SIZE));
+        v2 = v1;
+        assert(v2.GetAllocator().GetResource() == &arena2);
+        assert(v2.Size() == v1.Size());
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        PoolResource pool;
+        pmr::Vector<std::string> v{ &pool };
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack("element"s);
+        }
+        pmr::Vector<std::string> other{ &pool };
+        other.PushBack("other"s);
+        v.Swap(other);
+        assert(v.Size() == 1);
+        assert(other.Size() == SIZE);
+        assert(other[SIZE - 1] == "element"s);
+    }
+    {
+        PoolResource pool;
+        Vector<int, PoolAllocator<int>> v{ PoolAllocator<int>(pool) };
+        for (int round = 0; round < 3; ++round) {
+            Vector<int, PoolAllocator<int>> tmp(static_cast<size_t>(round) * 100 + 1, v.GetAllocator());
+            tmp[0] = round;
+            v = tmp;
+        }
+        assert(v[0] == 2);
+    }
+    {
+        // Слишком маленький кусок увеличивается так, что в нём помещается ячейка старшего класса
+        PoolResource pool(1);
+        void* large = pool.Allocate(PoolResource::MAX_CLASS, 8);
+        void* small = pool.Allocate(PoolResource::MIN_CLASS, 8);
+        assert(large != nullptr && small != nullptr && large != small);
+        std::memset(large, 0xAB, PoolResource::MAX_CLASS);
+        pool.Deallocate(small, PoolResource::MIN_CLASS, 8);
+        pool.Deallocate(large, PoolResource::MAX_CLASS, 8);
+        assert(pool.Allocate(PoolResource::MAX_CLASS, 8) == large);
+    }
+}
+
+void Test9() {
+    const size_t SIZE = 1000;
+    {
+        Vector<int, MallocAllocator<int>> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        v.Insert(v.cbegin() + 1, -1);
+        v.Reserve(SIZE * 100);
+        assert(v.Capacity() == SIZE * 100);
+        assert(v.Size() == SIZE + 1);
+        assert(v[0] == 0 && v[1] == -1 && v[SIZE] == static_cast<int>(SIZE - 1));
+    }
+    {
+        Vector<TestObj, MallocAllocator<TestObj>> v(1);
+        // Вставка существующего элемента безопасна и при перевыделении через realloc
+        v.PushBack(v[0]);
+        v.Insert(v.cbegin(), v[1]);
+        assert(v.Size() == 3);
+        assert(std::all_of(v.begin(), v.end(), [](const TestObj& obj) {
+            return obj.IsAlive();
+            }));
+    }
+    {
+        Handle::num_moved = 0;
+        Vector<Handle, MallocAllocator<Handle>> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        assert(Handle::num_moved == 0);
+        assert(*v[SIZE - 1].ptr == static_cast<int>(SIZE - 1));
+    }
+    Obj::ResetCounters();
+    {
+        MonotonicArena arena(SIZE * sizeof(Obj) * 4);
+        Vector<Obj, ArenaAllocator<Obj>> v(SIZE, ArenaAllocator<Obj>(arena));
+        const Obj* data = &v[0];
+        // Последний блок арены расширяется на месте, без переноса элементов
+        v.Reserve(SIZE * 2);
+        v.PushBack(Obj{ 1 });
+        assert(&v[0] == data);
+        assert(v.Capacity() == SIZE * 2);
+        assert(Obj::num_moved == 1);
+        assert(arena.BytesAllocated() == SIZE * 2 * sizeof(Obj));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test10() {
+    {
+        Vector<int, std::allocator<int>, OneAndHalfGrowth> v;
+        std::vector<size_t> capacities;
+        for (int i = 0; i < 20; ++i) {
+            v.PushBack(i);
+            if (capacities.empty() || capacities.back() != v.Capacity()) {
+                capacities.push_back(v.Capacity());
+            }
+        }
+        assert((capacities == std::vector<size_t>{ 1, 2, 3, 4, 6, 9, 13, 19, 28 }));
+        v.Insert(v.cbegin(), -1);
+        v.Insert(v.cbegin(), -2);
+        v.Insert(v.cbegin(), -3);
+        assert(v.Size() == 23);
+        assert(v[0] == -3);
+        assert(v[22] == 19);
+    }
+    {
+        using Growth = CacheLineMinimumGrowth<>;
+        Vector<int, std::allocator<int>, Growth> v;
+        v.PushBack(1);
+        assert(v.Capacity() == 64 / sizeof(int));
+        Vector<int, std::allocator<int>, Growth> w;
+        w.Emplace(w.cbegin(), 1);
+        assert(w.Capacity() == 64 / sizeof(int));
+        for (int i = 0; i < 16; ++i) {
+            w.PushBack(i);
+        }
+        assert(w.Capacity() == 2 * 64 / sizeof(int));
+    }
+    {
+        using Growth = PageRoundedGrowth<OneAndHalfGrowth, 4096, 4096>;
+        assert(Growth::NextCapacity(0, 1, 8) == 1);
+        assert(Growth::NextCapacity(1000, 1001, 8) == 1536);
+        assert(Growth::NextCapacity(1000, 1001, 24) == 1536);
+        assert(Growth::NextCapacity(1000, 1001, 100) == 1515);
     }
-    C(const C& /*other*/) noexcept {
-        ++copy_ctor;
+    {
+        const size_t huge = std::numeric_limits<size_t>::max() / 8;
+        assert(DoublingGrowth::NextCapacity(huge - 1, huge, 8) == huge);
+        assert(OneAndHalfGrowth::NextCapacity(huge - 1, huge, 8) == huge);
     }
-    C(C&& /*other*/) noexcept {
-        ++move_ctor;
+}
+
+void Test11() {
+    const size_t N = 8;
+    const int ID = 42;
+    using namespace std::literals;
+    Obj::ResetCounters();
+    {
+        SmallVector<Obj, N> v;
+        assert(v.Capacity() == N);
+        assert(v.IsInline());
+        for (size_t i = 0; i < N; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        assert(v.IsInline());
+        assert(Obj::num_moved == 0);
+        v.EmplaceBack(ID, "Ivan"s);
+        assert(!v.IsInline());
+        assert(v.Capacity() == N * 2);
+        assert(Obj::num_moved == static_cast<int>(N));
+        assert(v[N].id == ID && v[N].name == "Ivan"s);
+        v.Insert(v.cbegin() + 1, Obj{ ID });
+        assert(v.Size() == N + 2);
+        assert(v[1].id == ID && v[2].id == 1);
+        v.Erase(v.cbegin());
+        assert(v[0].id == ID);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(N + 1));
     }
-    C& operator=(const C& other) noexcept {
-        if (this != &other) {
-            ++copy_assign;
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        SmallVector<Obj, N> v(N);
+        v[N / 2].throw_on_copy = true;
+        try {
+            SmallVector<Obj, N> v_copy(v);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
         }
-        return *this;
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(N));
+        v.Reserve(N * 4);
+        assert(v.Capacity() == N * 4);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(N));
     }
-    C& operator=(C&& /*other*/) noexcept {
-        ++move_assign;
-        return *this;
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        SmallVector<TestObj, N> v(N);
+        // Вставка существующего элемента безопасна и при переходе в кучу
+        v.PushBack(v[0]);
+        v.Insert(v.cbegin() + 2, v[0]);
+        v.Emplace(v.cbegin() + 2, std::move(v[1]));
+        assert(std::all_of(v.begin(), v.end(), [](const TestObj& obj) {
+            return obj.IsAlive();
+            }));
     }
-    ~C() {
-        ++dtor;
+    {
+        SmallVector<std::string, N> small;
+        small.PushBack("small"s);
+        SmallVector<std::string, N> large;
+        for (size_t i = 0; i < N * 2; ++i) {
+            large.PushBack(std::to_string(i));
+        }
+        small.Swap(large);
+        assert(small.Size() == N * 2 && !small.IsInline());
+        assert(large.Size() == 1 && large.IsInline() && large[0] == "small"s);
+        SmallVector<std::string, N> other;
+        other.PushBack("a"s);
+        other.PushBack("b"s);
+        other.Swap(large);
+        assert(other.Size() == 1 && other[0] == "small"s);
+        assert(large.Size() == 2 && large[1] == "b"s);
+
+        SmallVector<std::string, N> moved(std::move(small));
+        assert(moved.Size() == N * 2 && moved[N] == std::to_string(N));
+        assert(small.Size() == 0);
+        moved = std::move(large);
+        assert(moved.Size() == 2 && moved.IsInline() && moved[0] == "a"s);
+        SmallVector<std::string, N> copy(moved);
+        copy.Resize(N * 3);
+        assert(copy.Size() == N * 3 && copy[1] == "b"s);
+        moved = copy;
+        assert(moved.Size() == N * 3 && moved[0] == "a"s);
+        copy.Resize(1);
+        moved = copy;
+        assert(moved.Size() == 1);
+        moved.PopBack();
+        assert(moved.Size() == 0);
     }
+}
 
-    static void Reset() {
-        def_ctor = 0;
-        copy_ctor = 0;
-        move_ctor = 0;
-        copy_assign = 0;
-        move_assign = 0;
-        dtor = 0;
+void Test12() {
+    const size_t SIZE = 10;
+    {
+        Vector<int> v{ 1, 2, 3 };
+        assert(v.Size() == 3 && v.Capacity() == 3);
+        const std::vector<int> src{ 10, 11, 12, 13 };
+        auto pos = v.Insert(v.cbegin() + 1, src.begin(), src.end());
+        assert(pos == v.begin() + 1);
+        assert((std::vector<int>(v.begin(), v.end()) == std::vector<int>{ 1, 10, 11, 12, 13, 2, 3 }));
+        v.Insert(v.cbegin(), 2, v[3]);
+        assert((std::vector<int>(v.begin(), v.end()) == std::vector<int>{ 12, 12, 1, 10, 11, 12, 13, 2, 3 }));
+        const std::list<int> tail{ 7, 8 };
+        v.Append(tail.begin(), tail.end());
+        assert(v.Size() == 11 && v[9] == 7 && v[10] == 8);
+        std::istringstream input("4 5 6");
+        v.Assign(std::istream_iterator<int>(input), std::istream_iterator<int>());
+        assert((std::vector<int>(v.begin(), v.end()) == std::vector<int>{ 4, 5, 6 }));
+        std::istringstream more("1 2");
+        v.Insert(v.cbegin() + 1, std::istream_iterator<int>(more), std::istream_iterator<int>());
+        assert((std::vector<int>(v.begin(), v.end()) == std::vector<int>{ 4, 1, 2, 5, 6 }));
     }
+    Obj::ResetCounters();
+    {
+        Vector<Obj> v(SIZE);
+        std::vector<Obj> src;
+        for (int i = 1; i <= 3; ++i) {
+            src.emplace_back(i);
+        }
+        int copied = Obj::num_copied;
+        int moved = Obj::num_moved;
+        int assigned = Obj::num_assigned;
+        const auto take = [&copied, &moved, &assigned] {
+            const int result[] = { Obj::num_copied - copied, Obj::num_moved - moved, Obj::num_assigned - assigned };
+            copied = Obj::num_copied;
+            moved = Obj::num_moved;
+            assigned = Obj::num_assigned;
+            return std::vector<int>(std::begin(result), std::end(result));
+        };
+        // Одно перевыделение и однократный перенос хвоста
+        v.Insert(v.cbegin() + 2, src.begin(), src.end());
+        assert(v.Size() == SIZE + 3);
+        assert(v.Capacity() == SIZE * 2);
+        assert((take() == std::vector<int>{ 3, static_cast<int>(SIZE), 0 }));
+        assert(v[2].id == 1 && v[4].id == 3 && v[5].id == 0);
 
-    inline static size_t def_ctor = 0;
-    inline static size_t copy_ctor = 0;
-    inline static size_t move_ctor = 0;
-    inline static size_t copy_assign = 0;
-    inline static size_t move_assign = 0;
-    inline static size_t dtor = 0;
-};
+        v.Insert(v.cbegin() + 1, src.begin(), src.end());
+        assert(v.Capacity() == SIZE * 2);
+        assert((take() == std::vector<int>{ 0, 3, 3 }));
+        assert(v[1].id == 1 && v[3].id == 3 && v[4].id == 0 && v[5].id == 1);
+
+        v.Insert(v.end() - 1, src.begin(), src.end());
+        assert(v.Size() == SIZE + 9);
+        assert((take() == std::vector<int>{ 2, 1, 1 }));
+        assert(v[SIZE + 5].id == 1 && v[SIZE + 7].id == 3);
 
-void Dump() {
-    using namespace std;
-    cerr << "Def ctors: "sv << C::def_ctor              //
-        << ", Copy ctors: "sv << C::copy_ctor          //
-        << ", Move ctors: "sv << C::move_ctor          //
-        << ", Copy assignments: "sv << C::copy_assign  //
-        << ", Move assignments: "sv << C::move_assign  //
-        << ", Dtors: "sv << C::dtor << endl;
+        src[1].throw_on_copy = true;
+        const size_t old_size = v.Size();
+        try {
+            v.Insert(v.cbegin(), src.begin(), src.end());
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == old_size);
+        assert(v.Capacity() == SIZE * 2);
+        assert(v[1].id == 1);
+        v.Assign(src.begin(), src.begin() + 1);
+        assert(v.Size() == 1 && v[0].id == 1);
+    }
+    {
+        Vector<std::string> v;
+        const std::string words[] = { "a", "b", "c" };
+        v.Append(std::begin(words), std::end(words));
+        v.Insert(v.cbegin() + 1, 3, "x");
+        v.Assign(v.begin() + 1, v.begin() + 3);
+        assert(v.Size() == 2 && v[0] == "x" && v[1] == "x");
+        Vector<std::string> w{ "a", "b", "c", "d" };
+        w.Assign(std::begin(words), std::begin(words) + 2);
+        assert(w.Size() == 2 && w[1] == "b");
+    }
+    {
+        Vector<TestObj> v(SIZE);
+        v.Insert(v.cbegin() + 2, SIZE, v[SIZE - 1]);
+        assert(v.Size() == SIZE * 2);
+        assert(std::all_of(v.begin(), v.end(), [](const TestObj& obj) {
+            return obj.IsAlive();
+            }));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
 }
 
-void Benchmark() {
-    using namespace std;
-    try {
-        const size_t NUM = 10;
-        C c;
-        {
-            cerr << "std::vector:"sv << endl;
-            C::Reset();
-            vector<C> v(NUM);
-            Dump();
-            v.push_back(c);
+void Test13() {
+    const size_t SIZE = 10;
+    {
+        Vector<int> v{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+        auto pos = v.Erase(v.cbegin() + 2, v.cbegin() + 5);
+        assert(pos == v.begin() + 2 && *pos == 5);
+        assert((std::vector<int>(v.begin(), v.end()) == std::vector<int>{ 0, 1, 5, 6, 7, 8, 9 }));
+        assert(EraseIf(v, [](int x) {
+            return x % 2 == 1;
+            }) == 4);
+        assert((std::vector<int>(v.begin(), v.end()) == std::vector<int>{ 0, 6, 8 }));
+        assert(EraseValue(v, 6) == 1);
+        assert(EraseValue(v, 6) == 0);
+        assert(v.Size() == 2 && v[1] == 8);
+        v.Erase(v.cbegin(), v.cend());
+        assert(v.Size() == 0);
+    }
+    Obj::ResetCounters();
+    {
+        Vector<Obj> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].id = static_cast<int>(i);
+        }
+        v.Erase(v.cbegin() + 1, v.cbegin() + 3);
+        assert(Obj::num_move_assigned == static_cast<int>(SIZE - 3));
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE - 2));
+        assert(v[1].id == 3);
+        assert(EraseIf(v, [](const Obj& obj) {
+            return obj.id > 5;
+            }) == 4);
+        assert(v.Size() == SIZE - 6 && v[3].id == 5);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE - 6));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Vector<Handle> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.EmplaceBack(i);
+        }
+        Handle::num_moved = 0;
+        assert(EraseIf(v, [](const Handle& h) {
+            return *h.ptr % 3 == 0;
+            }) == 4);
+        assert(Handle::num_moved == 0);
+        assert(v.Size() == SIZE - 4 && *v[0].ptr == 1 && *v[2].ptr == 4);
+        int checked = 0;
+        try {
+            EraseIf(v, [&checked](const Handle& h) {
+                if (++checked == 3) {
+                    throw std::runtime_error("Oops");
+                }
+                return *h.ptr == 1;
+                });
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
         }
-        Dump();
+        assert(v.Size() == SIZE - 5);
+        assert(*v[0].ptr == 2 && *v[1].ptr == 4 && *v[2].ptr == 5);
+        v.Erase(v.cbegin(), v.cbegin() + 2);
+        assert(v.Size() == SIZE - 7 && *v[0].ptr == 5);
+    }
+}
+
+void Test14() {
+    const size_t SIZE = 100;
+    Obj::ResetCounters();
+    {
+        Vector<Obj> v(SIZE, DEFAULT_INIT);
+        assert(v.Size() == SIZE);
+        v.ResizeDefaultInit(SIZE * 2);
+        assert(v.Size() == SIZE * 2 && v.Capacity() == SIZE * 2);
+        assert(Obj::num_default_constructed == static_cast<int>(SIZE * 2));
+        v.ResizeDefaultInit(SIZE / 2);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE / 2));
     }
-    catch (...) {
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Vector<char> buffer;
+        const std::string message = "hello, world";
+        buffer.ResizeAndOverwrite(SIZE, [&message](char* tail, size_t count) {
+            assert(count == SIZE);
+            std::copy(message.begin(), message.end(), tail);
+            return message.size();
+            });
+        assert(buffer.Size() == message.size());
+        assert(buffer.Capacity() == SIZE);
+        assert(std::string(buffer.begin(), buffer.end()) == message);
+        buffer.ResizeAndOverwrite(buffer.Size() + 1, [](char* tail, size_t count) {
+            assert(count == 1);
+            *tail = '!';
+            return size_t{ 1 };
+            });
+        assert(std::string(buffer.begin(), buffer.end()) == message + "!");
+        buffer.ResizeAndOverwrite(5, [](char*, size_t) {
+            assert(false && "Operation must not be called when shrinking");
+            return size_t{ 0 };
+            });
+        assert(std::string(buffer.begin(), buffer.end()) == "hello");
     }
-    try {
-        const size_t NUM = 10;
-        C c;
-        {
-            cerr << "Vector:"sv << endl;
-            C::Reset();
-            Vector<C> v(NUM);
-            Dump();
-            v.PushBack(c);
+    {
+        Vector<int> v(SIZE, DEFAULT_INIT);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i] = static_cast<int>(i);
         }
-        Dump();
+        v.ResizeDefaultInit(SIZE * 3);
+        assert(v[SIZE - 1] == static_cast<int>(SIZE - 1));
     }
-    catch (...) {
+}
+
+void Test15() {
+    const size_t SIZE = 100;
+    Obj::ResetCounters();
+    {
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 4);
+        v[SIZE - 1].id = 42;
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE && v.Size() == SIZE);
+        assert(v[SIZE - 1].id == 42);
+        assert(Obj::num_moved == static_cast<int>(SIZE * 2));
+        assert(!v.Trim());
+        v.Resize(SIZE / 10);
+        assert(v.Trim(0.5));
+        assert(v.Capacity() == SIZE / 10);
+        v.Clear();
+        assert(v.Size() == 0 && v.Capacity() == SIZE / 10);
+        assert(Obj::GetAliveObjectCount() == 0);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Копирование используется, если перемещение может выбросить исключение
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 2);
+        v[0].throw_on_copy = true;
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Vector<int, MallocAllocator<int>> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.PushBack(i);
+        }
+        v.Resize(10);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 10);
+        assert(v[9] == 9);
+    }
+}
+
+void Test16() {
+    ResetVectorStats();
+    {
+        Vector<TestObj> v;
+        for (int i = 0; i < 5; ++i) {
+            v.EmplaceBack();
+        }
+        v.ShrinkToFit();
+    }
+    {
+        Vector<MayThrowOnMove> v;
+        v.Reserve(2);
+        v.EmplaceBack(1);
+        v.EmplaceBack(2);
+        v.Emplace(v.begin(), 0);
+    }
+    const VectorStats stats = GetVectorStats<TestObj>();
+    const VectorStats tagged = GetVectorStats<MayThrowOnMove>();
+    if constexpr (INSTRUMENTATION_ENABLED) {
+        // Ёмкость 1, 2, 4, 8 при добавлении и 5 после ShrinkToFit
+        assert(stats.allocations == 5 && stats.deallocations == 5);
+        assert(stats.bytes_allocated == (1 + 2 + 4 + 8 + 5) * sizeof(TestObj));
+        assert(stats.reallocations == 4);
+        assert(stats.elements_relocated == 1 + 2 + 4 + 5);
+        assert(stats.copy_fallback_relocations == 0);
+        assert(stats.peak_capacity == 8);
+
+        assert(tagged.allocations == 2 && tagged.reallocations == 1);
+        assert(tagged.elements_relocated == 2 && tagged.copy_fallback_relocations == 2);
+        assert(tagged.peak_capacity == 4);
+
+        std::ostringstream csv;
+        ExportVectorStatsCsv(csv);
+        assert(csv.str().find("\nstats_tag,2,2,") != std::string::npos);
+        std::ostringstream json;
+        ExportVectorStatsJson(json);
+        assert(json.str().find("{\"tag\":\"stats_tag\",\"allocations\":2,") != std::string::npos);
+
+        ResetVectorStats();
+        assert(GetVectorStats<TestObj>().allocations == 0);
+    }
+    else {
+        assert(stats.allocations == 0 && tagged.elements_relocated == 0);
+        assert(SnapshotVectorStats().empty());
+    }
+}
+
+void Test17() {
+    const size_t SIZE = detail::PARALLEL_MIN_CHUNK * 4 + 3;
+    SetParallelThreadLimit(4);
+    {
+        Vector<Counted> v(PARALLEL, SIZE);
+        assert(v.Size() == SIZE && Counted::alive == static_cast<int>(SIZE));
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].value = static_cast<int>(i);
+        }
+        Vector<Counted> copy(PARALLEL, v);
+        assert(Counted::alive == static_cast<int>(SIZE * 2));
+        assert(copy[SIZE - 1].value == static_cast<int>(SIZE - 1));
+
+        Vector<Counted> other(3);
+        other.ParallelCopyFrom(copy);
+        assert(other.Size() == SIZE && other[SIZE / 2].value == static_cast<int>(SIZE / 2));
+        assert(Counted::alive == static_cast<int>(SIZE * 3));
+
+        // Исключение в одной из частей: созданные элементы уничтожаются, вектор не меняется
+        v[SIZE - 2].value = Counted::THROW_ON_COPY;
+        try {
+            other.ParallelCopyFrom(v);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(other.Size() == SIZE && other[SIZE - 2].value == static_cast<int>(SIZE - 2));
+        assert(Counted::alive == static_cast<int>(SIZE * 3));
+        try {
+            Vector<Counted> failed(PARALLEL, v);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(Counted::alive == static_cast<int>(SIZE * 3));
+
+        other.ParallelResize(SIZE * 2);
+        assert(other.Size() == SIZE * 2 && other[SIZE * 2 - 1].value == 0);
+        other.ParallelResize(10);
+        assert(other.Size() == 10 && other[9].value == 9);
+        copy.ParallelClear();
+        assert(copy.Size() == 0);
+        assert(Counted::alive == static_cast<int>(SIZE + 10));
+    }
+    assert(Counted::alive == 0);
+    {
+        // Небольшие векторы обрабатываются в текущем потоке
+        Vector<std::string> v(PARALLEL, 10);
+        v[0] = "a";
+        Vector<std::string> copy(PARALLEL, v);
+        assert(copy.Size() == 10 && copy[0] == "a");
+    }
+    SetParallelThreadLimit(0);
+}
+
+void Test18() {
+    const size_t SIZE = detail::PARALLEL_MIN_CHUNK * 4 + 1;
+    SetParallelThreadLimit(4);
+    {
+        // Counted не перемещается без исключений, поэтому при переносе элементы копируются частями
+        Vector<Counted> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].value = static_cast<int>(i);
+        }
+        v.Reserve(SIZE * 2);
+        assert(v.Capacity() == SIZE * 2 && Counted::alive == static_cast<int>(SIZE));
+        assert(v[SIZE - 1].value == static_cast<int>(SIZE - 1));
+
+        v[SIZE / 2].value = Counted::THROW_ON_COPY;
+        try {
+            v.Reserve(SIZE * 4);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Capacity() == SIZE * 2 && v.Size() == SIZE);
+        assert(Counted::alive == static_cast<int>(SIZE));
+        v[SIZE / 2].value = static_cast<int>(SIZE / 2);
+
+        while (v.Size() < v.Capacity()) {
+            v.EmplaceBack();
+        }
+        v.EmplaceBack().value = 7;
+        assert(v.Capacity() == SIZE * 4 && v[SIZE * 2].value == 7);
+        while (v.Size() < v.Capacity()) {
+            v.EmplaceBack();
+        }
+        v.Emplace(v.begin())->value = 8;
+        assert(v[0].value == 8 && v[SIZE].value == static_cast<int>(SIZE - 1));
+        assert(Counted::alive == static_cast<int>(v.Size()));
+    }
+    assert(Counted::alive == 0);
+    SetParallelThreadLimit(0);
+}
+
+// Сравнивает векторные версии поиска и сравнения со стандартными алгоритмами на массивах разной длины
+template <typename T, typename Make>
+void CheckSimdKernels(SimdLevel level, Make make) {
+    std::mt19937 random(42);
+    for (size_t size = 0; size < 300; size += 1 + size / 8) {
+        std::vector<T> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = make(random() % 4);
+        }
+        for (int v = 0; v < 5; ++v) {
+            const T value = make(v);
+            const size_t found = detail::FindValue(level, data.data(), size, value);
+            assert(found == static_cast<size_t>(std::find(data.begin(), data.end(), value) - data.begin()));
+            const size_t count = detail::CountValue(level, data.data(), size, value);
+            assert(count == static_cast<size_t>(std::count(data.begin(), data.end(), value)));
+        }
+        std::vector<T> other = data;
+        assert(detail::MismatchIndex(level, data.data(), other.data(), size) == size);
+        for (size_t pos = 0; pos < size; pos += 1 + pos / 4) {
+            other[pos] = make(9);
+            assert(detail::MismatchIndex(level, data.data(), other.data(), size) == pos);
+            other[pos] = data[pos];
+        }
+    }
+}
+
+void Test19() {
+    std::vector<SimdLevel> levels{ SimdLevel::SCALAR };
+    switch (ActiveSimdLevel()) {
+    case SimdLevel::AVX512:
+        levels.push_back(SimdLevel::AVX512);
+        [[fallthrough]];
+    case SimdLevel::AVX2:
+        levels.push_back(SimdLevel::AVX2);
+        [[fallthrough]];
+    case SimdLevel::SSE2:
+        levels.push_back(SimdLevel::SSE2);
+        break;
+    case SimdLevel::NEON:
+        levels.push_back(SimdLevel::NEON);
+        break;
+    default:
+        break;
+    }
+    enum class Color : uint16_t { RED, GREEN, BLUE };
+    static int targets[10];
+    for (SimdLevel level : levels) {
+        CheckSimdKernels<uint8_t>(level, [](unsigned v) { return static_cast<uint8_t>(v * 0x41); });
+        CheckSimdKernels<int16_t>(level, [](unsigned v) { return static_cast<int16_t>(v * 0x0101 - 1); });
+        CheckSimdKernels<int32_t>(level, [](unsigned v) { return static_cast<int32_t>(v << 16 | v); });
+        CheckSimdKernels<uint64_t>(level, [](unsigned v) { return uint64_t(v) << 32 | 7u; });
+        CheckSimdKernels<Color>(level, [](unsigned v) { return static_cast<Color>(v); });
+        CheckSimdKernels<int*>(level, [](unsigned v) { return &targets[v]; });
+        CheckSimdKernels<double>(level, [](unsigned v) { return v * 0.5; });
+    }
+
+    {
+        Vector<int> v(100, 7);
+        assert(v.Size() == 100 && v.Count(7) == 100);
+        Vector<int> zeros(50, 0);
+        assert(zeros[49] == 0 && !zeros.Contains(7));
+        v[60] = 3;
+        assert(v.Find(3) == v.begin() + 60 && v.Contains(3) && v.Find(4) == v.end());
+
+        Vector<int> copy = v;
+        assert(copy == v && !(copy != v) && copy <= v && copy >= v);
+        copy[80] = 2;
+        assert(copy != v && copy < v && v > copy);
+        copy.Resize(60);
+        assert(copy < v);
+        copy[10] = 8;
+        assert(v < copy);
+
+        v.Assign(10, v[60]);
+        assert(v.Size() == 10 && v.Count(3) == 10);
+        v.Assign(200, 5);
+        assert(v.Size() == 200 && v.Count(5) == 200);
+        v.Assign(150, 6);
+        assert(v.Size() == 150 && v.Capacity() == 200 && v.Count(6) == 150);
+    }
+    {
+        using namespace std::literals;
+        Vector<std::string> v(3, "ab"s);
+        assert(v.Count("ab"s) == 3);
+        v.Assign(5, v[0]);
+        assert(v.Size() == 5 && v[4] == "ab"s);
+        Vector<std::string> other(5, "ac"s);
+        assert(v < other && v != other);
+        assert(other.Find("ac"s) == other.begin() && !other.Contains("ab"s));
+        Vector<double> d(4, -0.0);
+        assert(d.Contains(0.0) && d == Vector<double>(4, 0.0));
+    }
+}
+
+void Test20() {
+    const auto is_aligned = [](const void* ptr, size_t alignment) {
+        return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+    };
+    {
+        Vector<float, AlignedAllocator<float, 32>> v;
+        static_assert(RawMemory<float, AlignedAllocator<float, 32>>::ALIGNMENT == 32);
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(static_cast<float>(i));
+            assert(is_aligned(&v[0], 32));
+        }
+        Vector<float, AlignedAllocator<float, 32>> copy = v;
+        assert(is_aligned(&copy[0], 32) && copy == v);
+        v.ShrinkToFit();
+        assert(is_aligned(&v[0], 32) && v[99] == 99.0f);
+    }
+    {
+        // Типы с повышенным выравниванием выравниваются и стандартным аллокатором
+        struct alignas(128) Wide {
+            int value = 0;
+        };
+        Vector<Wide> v;
+        for (int i = 0; i < 10; ++i) {
+            v.EmplaceBack().value = i;
+            assert(is_aligned(&v[0], 128));
+        }
+        static_assert(RawMemory<Wide, AlignedAllocator<Wide, 16>>::ALIGNMENT == 128);
+        Vector<Wide, AlignedAllocator<Wide, 16>> aligned(3);
+        assert(is_aligned(&aligned[0], 128));
+    }
+    {
+        // Ёмкость дополняется до целого числа кэш-линий
+        Vector<char, AlignedAllocator<char, 64, true>> v(3);
+        assert(v.Capacity() == 64 && is_aligned(&v[0], 64));
+        const char* data = &v[0];
+        v.ShrinkToFit();
+        assert(v.Capacity() == 64 && &v[0] == data);
+        v.Resize(65);
+        assert(v.Capacity() == 128);
+        Vector<double, AlignedAllocator<double, 64, true>> d;
+        d.Reserve(9);
+        assert(d.Capacity() == 16);
+        d.PushBack(1.0);
+        assert(d.Capacity() == 16);
+        Vector<double, AlignedAllocator<double, 64, true>> e;
+        e.PushBack(1.0);
+        assert(e.Capacity() == 8);
+    }
+    {
+        SmallVector<int, 2, AlignedAllocator<int, 64>> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(i);
+        }
+        assert(is_aligned(&v[0], 64) && v[9] == 9);
+    }
+}
+
+void Test21() {
+    // Порог понижен, чтобы тест проходил и через кучу, и через отображения
+    using Allocator = HugePageAllocator<int, 64 * 1024>;
+    const int SIZE = 1 << 20;
+    {
+        Vector<int, Allocator> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Size() == static_cast<size_t>(SIZE));
+        for (int i = 0; i < SIZE; i += 4099) {
+            assert(v[i] == i);
+        }
+        v.Resize(100);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 100 && v[99] == 99);
+        Vector<int, Allocator> copy(SIZE, 5);
+        assert(copy.Count(5) == static_cast<size_t>(SIZE));
+    }
+    {
+        Vector<std::string, HugePageAllocator<std::string, 64 * 1024>> v;
+        for (int i = 0; i < 10000; ++i) {
+            v.EmplaceBack(std::to_string(i));
+        }
+        assert(v[9999] == "9999");
+    }
+    {
+        HugePageOptions options;
+        options.explicit_huge_pages = true;
+        options.numa_node = 0;
+        Vector<int, Allocator> v{ Allocator(options) };
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(i);
+        }
+        assert(v[SIZE - 1] == SIZE - 1);
+        Vector<int, Allocator> other(Allocator{});
+        assert(v.GetAllocator() != other.GetAllocator());
+    }
+}
+
+void Test22() {
+#if defined(ADVANCED_VECTOR_HAS_MMAP)
+    struct Row {
+        int32_t id;
+        double value;
+    };
+    const std::string path = (std::filesystem::temp_directory_path() / "advanced_vector_test22.bin").string();
+    std::filesystem::remove(path);
+    const int SIZE = 10000;
+    {
+        MappedVector<Row> v(path, MapMode::READ_WRITE);
+        assert(v.Size() == 0 && v.Capacity() == 0);
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack({ i, i * 0.5 });
+        }
+        v.EmplaceBack(Row{ -1, 0.0 });
+        v.PopBack();
+        v.Flush();
+    }
+    {
+        // Повторное открытие на запись дописывает в конец
+        MappedVector<Row> v(path, MapMode::READ_WRITE);
+        assert(v.Size() == static_cast<size_t>(SIZE));
+        v.Resize(SIZE + 2);
+        assert(v[SIZE + 1].id == 0);
+        v[SIZE + 1].id = 42;
+    }
+    {
+        const MappedVector<Row> v(path, MapMode::READ_ONLY);
+        assert(v.Size() == static_cast<size_t>(SIZE + 2) && v.GetMode() == MapMode::READ_ONLY);
+        assert(v[123].id == 123 && v[123].value == 61.5 && v[SIZE + 1].id == 42);
+        assert(std::distance(v.begin(), v.end()) == SIZE + 2);
+    }
+    {
+        MappedVector<Row> v(path, MapMode::READ_ONLY);
+        try {
+            v.PushBack({ 0, 0.0 });
+            assert(false);
+        }
+        catch (const std::logic_error&) {
+        }
+    }
+    {
+        // Изменения копии при записи не попадают в файл даже при росте
+        MappedVector<Row> v(path, MapMode::COPY_ON_WRITE);
+        v[0].id = 7;
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack({ i, 0.0 });
+        }
+        assert(v.Size() == static_cast<size_t>(SIZE * 2 + 2) && v[0].id == 7 && v[SIZE + 1].id == 42);
+        MappedVector<Row> moved(std::move(v));
+        assert(!v.IsOpen() && moved.Size() == static_cast<size_t>(SIZE * 2 + 2));
+    }
+    {
+        MappedVector<Row> v(path, MapMode::READ_ONLY);
+        assert(v.Size() == static_cast<size_t>(SIZE + 2) && v[0].id == 0);
+    }
+    try {
+        MappedVector<int64_t> v(path, MapMode::READ_ONLY);
+        assert(false);
+    }
+    catch (const std::runtime_error& e) {
+        assert(std::string(e.what()).find("another type") != std::string::npos);
+    }
+    try {
+        MappedVector<Row> v(path + ".missing", MapMode::READ_ONLY);
+        assert(false);
+    }
+    catch (const std::system_error& e) {
+        assert(e.code() == std::errc::no_such_file_or_directory);
+    }
+    std::filesystem::remove(path);
+#endif
+}
+
+void Test23() {
+    using namespace std::literals;
+    {
+        Vector<uint32_t> v;
+        for (uint32_t i = 0; i < 100000; ++i) {
+            v.PushBack(i * 3);
+        }
+        std::stringstream stream;
+        WriteVector(stream, v);
+        assert(stream.str().size() == sizeof(SerializedVectorHeader) + v.Size() * sizeof(uint32_t));
+        Vector<uint32_t> restored(5);
+        ReadVector(stream, restored, 1000);
+        assert(restored == v && restored.Capacity() == v.Size());
+
+        // Обрезанные данные и чужой тип элементов
+        std::stringstream truncated(stream.str().substr(0, 1000));
+        try {
+            ReadVector(truncated, restored);
+            assert(false);
+        }
+        catch (const std::ios_base::failure&) {
+        }
+        std::stringstream other_type(stream.str());
+        Vector<uint64_t> wrong;
+        try {
+            ReadVector(other_type, wrong);
+            assert(false);
+        }
+        catch (const std::runtime_error& e) {
+            assert(std::string(e.what()).find("another type") != std::string::npos);
+        }
+    }
+    {
+        Vector<Vector<std::string>> v;
+        v.EmplaceBack(Vector<std::string>{ "a"s, ""s, std::string(5000, 'x') });
+        v.EmplaceBack();
+        std::stringstream stream;
+        WriteVector(stream, v);
+        Vector<Vector<std::string>> restored;
+        ReadVector(stream, restored);
+        assert(restored.Size() == 2 && restored[0] == v[0] && restored[1].Size() == 0);
+    }
+    {
+        // Порции произвольного размера, не кратные размеру элемента
+        Vector<uint64_t> source;
+        for (uint64_t i = 0; i < 1000; ++i) {
+            source.PushBack(i * i);
+        }
+        std::stringstream stream;
+        WriteVector(stream, source);
+        const std::string bytes = stream.str();
+        SerializedVectorHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        Vector<uint64_t> target;
+        AsyncVectorReader<uint64_t> reader(target, header);
+        size_t offset = sizeof(header);
+        while (!reader.Done()) {
+            const IoBuffer buffer = reader.Submit(13);
+            std::memcpy(buffer.data, bytes.data() + offset, buffer.bytes);
+            offset += buffer.bytes;
+            reader.Complete(buffer.bytes);
+        }
+        assert(target == source && offset == bytes.size() && target.Capacity() == 1000);
+    }
+#if defined(ADVANCED_VECTOR_HAS_POSIX_IO)
+    {
+        const std::string path = (std::filesystem::temp_directory_path() / "advanced_vector_test23.bin").string();
+        FILE* file = std::fopen(path.c_str(), "w+b");
+        assert(file != nullptr);
+        const int fd = fileno(file);
+        Vector<int16_t> v(70000, 0);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            v[i] = static_cast<int16_t>(i);
+        }
+        WriteVector(fd, v);
+        Vector<std::string> strings{ "abc"s, "de"s };
+        WriteVector(fd, strings);
+        lseek(fd, 0, SEEK_SET);
+        Vector<int16_t> restored;
+        ReadVector(fd, restored, 4096);
+        assert(restored == v);
+        std::fclose(file);
+        std::filesystem::remove(path);
+    }
+#endif
+}
+
+void Test24() {
+    {
+        SegmentedVector<int, std::allocator<int>, 16> v;
+        v.PushBack(0);
+        int* first = &v[0];
+        const auto it = v.begin();
+        Vector<int*> addresses;
+        for (int i = 1; i < 1000; ++i) {
+            addresses.PushBack(&v.EmplaceBack(i));
+        }
+        // Рост не перемещает элементы и не инвалидирует итераторы
+        assert(first == &v[0] && *it == 0 && v.Size() == 1000);
+        for (int i = 1; i < 1000; ++i) {
+            assert(addresses[i - 1] == &v[i] && v[i] == i);
+        }
+        assert(v.Capacity() == 1008 && v.SegmentCount() == 63);
+        assert(v.end() - v.begin() == 1000 && *(v.begin() + 500) == 500);
+        assert(std::accumulate(v.cbegin(), v.cend(), 0) == 999 * 1000 / 2);
+
+        Vector<int> flat = v.Flatten();
+        assert(flat.Size() == 1000 && flat.Capacity() == 1000 && std::equal(flat.begin(), flat.end(), v.begin()));
+
+        v.Resize(20);
+        assert(v.Size() == 20 && v.Capacity() == 1008);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 32);
+        v.PopBack();
+        assert(v.Size() == 19 && v[18] == 18);
+    }
+    {
+        // Таблица сегментов при росте по одному элементу перевыделяется геометрически,
+        // а не при каждом новом сегменте
+        AllocationCounter::allocations = 0;
+        SegmentedVector<int, CountingAllocator<int>, 16> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(i);
+        }
+        const int table_allocations = AllocationCounter::allocations - static_cast<int>(v.SegmentCount());
+        assert(v.SegmentCount() == 63 && table_allocations <= 7);
+        // Явный Reserve выделяет таблицу точно под нужное число сегментов
+        AllocationCounter::allocations = 0;
+        SegmentedVector<int, CountingAllocator<int>, 16> reserved;
+        reserved.Reserve(1000);
+        assert(reserved.SegmentCount() == 63 && AllocationCounter::allocations == 64);
+    }
+    {
+        Counted::alive = 0;
+        {
+            SegmentedVector<Counted, std::allocator<Counted>, 4> v;
+            for (int i = 0; i < 10; ++i) {
+                v.EmplaceBack().value = i;
+            }
+            SegmentedVector<Counted, std::allocator<Counted>, 4> copy(v);
+            assert(Counted::alive == 20 && copy[9].value == 9);
+
+            Counted bad;
+            bad.value = Counted::THROW_ON_COPY;
+            Counted* last = &v[9];
+            for (int i = 10; i < 12; ++i) {
+                v.EmplaceBack().value = i;
+            }
+            try {
+                v.PushBack(bad);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(v.Size() == 12 && &v[9] == last && Counted::alive == 23);
+
+            Vector<Counted> flat = std::move(v).Flatten();
+            assert(flat.Size() == 12 && flat[11].value == 11 && v.Size() == 0 && v.Capacity() == 0);
+            assert(Counted::alive == 23);
+
+            v = copy;
+            assert(v.Size() == 10 && Counted::alive == 33);
+            v.Clear();
+            assert(Counted::alive == 23 && v.Capacity() == 12);
+        }
+        assert(Counted::alive == 0);
+    }
+    {
+        SegmentedVector<std::string> v(3);
+        v[1] = "segmented";
+        SegmentedVector<std::string> moved(std::move(v));
+        assert(moved.Size() == 3 && moved[1] == "segmented" && v.Size() == 0);
+        const SegmentedVector<std::string>& ref = moved;
+        assert(ref.begin()->empty() && ref[1].size() == 9);
+        static_assert(SegmentedVector<std::string>::SEGMENT_SIZE * sizeof(std::string) <= 4096);
+    }
+}
+
+void Test25() {
+    {
+        constexpr size_t THREADS = 8;
+        constexpr size_t PER_THREAD = 20000;
+        ConcurrentVector<uint64_t> v;
+        const uint64_t& first = v.EmplaceBack(uint64_t(-1));
+        std::atomic<bool> done{ false };
+        // Читатель видит только опубликованные элементы, и их число не убывает
+        std::thread reader([&] {
+            size_t seen = 0;
+            while (!done.load()) {
+                const size_t size = v.Size();
+                assert(size >= seen);
+                for (size_t i = seen; i < size; ++i) {
+                    assert(v[i] == uint64_t(-1) || v[i] % PER_THREAD < PER_THREAD);
+                }
+                seen = size;
+            }
+        });
+        std::vector<std::thread> writers;
+        for (size_t t = 0; t < THREADS; ++t) {
+            writers.emplace_back([&v, t] {
+                for (size_t i = 0; i < PER_THREAD; ++i) {
+                    uint64_t& elem = v.EmplaceBack(t * PER_THREAD + i);
+                    assert(elem == t * PER_THREAD + i);
+                }
+            });
+        }
+        for (std::thread& writer : writers) {
+            writer.join();
+        }
+        done = true;
+        reader.join();
+        assert(v.Size() == THREADS * PER_THREAD + 1 && &v[0] == &first && v.Capacity() >= v.Size());
+        Vector<uint64_t> flat = v.Flatten();
+        std::sort(flat.begin(), flat.end());
+        assert(flat.Size() == v.Size() && flat[0] == 0 && flat[flat.Size() - 1] == uint64_t(-1));
+        for (size_t i = 0; i + 1 < flat.Size(); ++i) {
+            assert(flat[i] == i);
+        }
+    }
+    {
+        // Создание из аргументов может выбросить исключение, перемещение — нет
+        struct Event {
+            explicit Event(int id)
+                : id(id)  //
+            {
+                if (id == Counted::THROW_ON_COPY) {
+                    throw std::runtime_error("Oops");
+                }
+            }
+            Event(Event&& other) noexcept
+                : id(other.id)  //
+            {
+            }
+
+            int id;
+            Counted counted;
+        };
+        ConcurrentVector<Event> v;
+        v.Reserve(100);
+        assert(v.Capacity() >= 100 && v.Size() == 0);
+        Counted::alive = 0;
+        v.EmplaceBack(1);
+        try {
+            v.EmplaceBack(Counted::THROW_ON_COPY);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        // Исключение не оставило пропуска: следующий элемент занимает место сразу за первым
+        v.EmplaceBack(2);
+        assert(v.Size() == 2 && v[1].id == 2 && Counted::alive == 2);
+        v.Clear();
+        assert(v.Size() == 0 && Counted::alive == 0 && v.Capacity() >= 100);
+        v.EmplaceBack(3);
+        assert(v.Size() == 1 && Counted::alive == 1);
+    }
+    {
+        ConcurrentVector<std::string> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.EmplaceBack(std::to_string(i));
+        }
+        const Vector<std::string> flat = v.Flatten();
+        assert(flat.Size() == 1000 && flat[999] == "999" && v[500] == "500");
+    }
+}
+
+void Test26() {
+    static_assert(StaticVectorSum() == 8064);
+    static_assert(std::is_trivially_copyable_v<StaticVector<int, 4>>);
+    static_assert(std::is_trivially_destructible_v<StaticVector<Handle*, 4>>);
+    static_assert(!std::is_trivially_copyable_v<StaticVector<std::string, 4>>);
+    static_assert(sizeof(StaticVector<uint8_t, 16>) == 16 + sizeof(size_t));
+    static_assert(StaticVector<int, 3>::Capacity() == 3);
+    {
+        constexpr StaticVector<int, 4> v = { 1, 2, 3 };
+        static_assert(v.Size() == 3 && v[2] == 3);
+        StaticVector<int, 4> runtime(2, 7);
+        runtime.EmplaceBack(8);
+        runtime.PushBack(9);
+        try {
+            runtime.PushBack(10);
+            assert(false);
+        }
+        catch (const std::length_error&) {
+        }
+        assert(runtime.Size() == 4 && runtime[3] == 9);
+        try {
+            runtime.Resize(5);
+            assert(false);
+        }
+        catch (const std::length_error&) {
+        }
+    }
+    {
+        Counted::alive = 0;
+        {
+            StaticVector<Counted, 8> v(3);
+            v[1].value = 1;
+            StaticVector<Counted, 8> copy(v);
+            assert(Counted::alive == 6 && copy[1].value == 1);
+            copy.Erase(copy.begin());
+            assert(Counted::alive == 5 && copy[0].value == 1 && copy.Size() == 2);
+            Counted bad;
+            bad.value = Counted::THROW_ON_COPY;
+            try {
+                v.PushBack(bad);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(v.Size() == 3 && Counted::alive == 6);
+            v = copy;
+            assert(v.Size() == 2 && Counted::alive == 5);
+        }
+        assert(Counted::alive == 0);
+    }
+    {
+        StaticVector<std::string, 5> v{ "b", "d" };
+        const std::string a = "a";
+        v.Insert(v.begin(), a);
+        v.Emplace(v.begin() + 2, 1, 'c');
+        // Аргумент ссылается на элемент самого вектора
+        v.Insert(v.begin(), v[3]);
+        assert(v.Size() == 5 && v[0] == "d" && v[1] == "a" && v[2] == "b" && v[3] == "c" && v[4] == "d");
+        StaticVector<std::string, 5> moved(std::move(v));
+        assert(moved.Size() == 5 && moved[3] == "c");
+        moved.Clear();
+        assert(moved.Size() == 0);
+    }
+}
+
+void Test27() {
+    {
+        Vector<uint32_t> source(100);
+        for (uint32_t i = 0; i < 100; ++i) {
+            source[i] = i;
+        }
+        Vector<uint32_t> target(10);
+        const uint32_t* old_data = target.Data();
+        target = source;
+        // Ёмкости не хватило: буфер выделен ровно под копию
+        assert(target == source && target.Capacity() == 100 && target.Data() != old_data);
+        Vector<uint32_t> small{ 1, 2, 3 };
+        target = small;
+        assert(target == small && target.Capacity() == 100);
+        const Vector<uint32_t> empty;
+        target = empty;
+        assert(target.Size() == 0 && target.Capacity() == 100);
+    }
+    {
+        Counted::alive = 0;
+        {
+            Vector<Counted> source(5);
+            source[4].value = 4;
+            Vector<Counted> target(8);
+            target = source;
+            assert(target.Size() == 5 && target.Capacity() == 8 && target[4].value == 4 && Counted::alive == 10);
+            Vector<Counted> big(20);
+            big[19].value = Counted::THROW_ON_COPY;
+            try {
+                target = big;
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            // При нехватке ёмкости исключение оставляет вектор прежним
+            assert(target.Size() == 5 && target.Capacity() == 8 && target[4].value == 4 && Counted::alive == 30);
+            big[19].value = 19;
+            target = big;
+            assert(target.Size() == 20 && target.Capacity() == 20 && target[19].value == 19 && Counted::alive == 45);
+        }
+        assert(Counted::alive == 0);
+    }
+}
+
+void Test28() {
+    const size_t SIZE = 10;
+    {
+        // Элемент создаётся на месте без временного объекта: одно перемещение в конец буфера
+        // и одно для самого элемента
+        Obj::ResetCounters();
+        Vector<Obj> v{ SIZE };
+        v.Reserve(SIZE * 2);
+        const int moved_before = Obj::num_moved;
+        auto pos = v.Insert(v.cbegin() + 3, Obj{ 7 });
+        assert(&*pos == &v[3] && v[3].id == 7 && v.Size() == SIZE + 1);
+        assert(Obj::num_moved - moved_before == 2);
+        assert(Obj::num_move_assigned == static_cast<int>(SIZE) - 4);
+        assert(Obj::num_copied == 0 && Obj::num_assigned == 0);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE) + 1);
+    }
+    {
+        // Аргумент ссылается на сдвигаемый элемент
+        Obj::ResetCounters();
+        Vector<Obj> v{ SIZE };
+        v.Reserve(SIZE * 2);
+        v[5].id = 5;
+        v.Insert(v.cbegin() + 1, v[5]);
+        assert(v[1].id == 5 && v[6].id == 5 && Obj::num_copied == 1);
+        v.Emplace(v.cbegin(), std::move(v[6]));
+        assert(v[0].id == 5 && v.Size() == SIZE + 2);
+    }
+    {
+        Handle::num_moved = 0;
+        Vector<Handle> v;
+        v.Reserve(8);
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Emplace(v.cbegin() + 1, 10);
+        v.Emplace(v.cbegin(), 20);
+        // Хвост сдвигается побайтово, элементы не перемещаются конструктором
+        assert(Handle::num_moved == 0);
+        assert(*v[0].ptr == 20 && *v[1].ptr == 0 && *v[2].ptr == 10 && *v[5].ptr == 3);
+    }
+    {
+        Vector<int> v{ 1, 2, 3, 4, 5 };
+        v.Reserve(10);
+        v.Insert(v.cbegin() + 1, v[3]);
+        v.Insert(v.cbegin(), v[0]);
+        assert((v == Vector<int>{ 1, 1, 4, 2, 3, 4, 5 }));
+
+        Vector<Checked> checked;
+        checked.Reserve(4);
+        checked.EmplaceBack(1);
+        checked.EmplaceBack(2);
+        try {
+            checked.Emplace(checked.cbegin(), -1);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+        // После исключения хвост возвращён на место
+        assert(checked.Size() == 2 && checked[0].value == 1 && checked[1].value == 2);
+    }
+}
+
+template <typename T, typename Make>
+void CheckGapVectorEdits(Make make) {
+    std::mt19937 random(42);
+    GapVector<T> v;
+    std::vector<T> expected;
+    for (int step = 0; step < 3000; ++step) {
+        const size_t size = expected.size();
+        const size_t index = std::uniform_int_distribution<size_t>(0, size)(random);
+        const int action = std::uniform_int_distribution<int>(0, 9)(random);
+        if (action < 6 || size == 0) {
+            const T value = make(step);
+            v.Insert(index, value);
+            expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(index), value);
+        }
+        else if (action < 9) {
+            const size_t last = std::min(size, index + std::uniform_int_distribution<size_t>(1, 3)(random));
+            const size_t first = std::min(index, size - 1);
+            v.Erase(first, last);
+            expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(first), expected.begin() + static_cast<std::ptrdiff_t>(last));
+        }
+        else {
+            // Аргумент ссылается на элемент самого вектора
+            const size_t source = std::min(index, size - 1);
+            v.Emplace(index, v[source]);
+            expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(index), T(expected[source]));
+        }
+        assert(v.Size() == expected.size());
+    }
+    assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+    const Vector<T> copy = v.Compact();
+    assert(std::equal(copy.begin(), copy.end(), expected.begin(), expected.end()));
+    const GapVector<T> gap_copy(v);
+    assert(gap_copy.Size() == v.Size() && gap_copy.GapPosition() == v.Size());
+    Vector<T> moved = std::move(v).Compact();
+    assert(moved == copy && v.Size() == 0);
+}
+
+void Test29() {
+    CheckGapVectorEdits<int>([](int i) {
+        return i;
+    });
+    CheckGapVectorEdits<std::string>([](int i) {
+        return "value-" + std::to_string(i) + std::string(20, 'x');
+    });
+    {
+        GapVector<int> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(i);
+        }
+        v.MoveGap(3);
+        assert(v.GapPosition() == 3);
+        // Правки рядом с промежутком не сдвигают остальные элементы
+        v.Insert(3, 100);
+        v.Insert(4, 101);
+        v.Erase(2);
+        assert(v.GapPosition() == 2 && v.Size() == 11);
+        assert(v[2] == 100 && v[3] == 101 && v[4] == 3 && v[10] == 9);
+        v.Erase(1, 5);
+        assert(v.Size() == 7 && v[0] == 0 && v[1] == 4);
+        v.PopBack();
+        assert(v.Size() == 6 && v[5] == 8);
+        const auto& cv = v;
+        assert(std::accumulate(cv.begin(), cv.end(), 0) == 0 + 4 + 5 + 6 + 7 + 8);
+    }
+    {
+        Counted::alive = 0;
+        {
+            GapVector<Counted> v;
+            v.Reserve(8);
+            for (int i = 0; i < 6; ++i) {
+                v.EmplaceBack().value = i;
+            }
+            v[2].value = Counted::THROW_ON_COPY;
+            // Элементы переносятся копированием, и копирование третьего элемента выбрасывает исключение
+            try {
+                v.MoveGap(0);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(v.Size() == 6 && v.GapPosition() == 3 && Counted::alive == 6);
+            for (int i = 0; i < 6; ++i) {
+                assert(v[i].value == (i == 2 ? Counted::THROW_ON_COPY : i));
+            }
+            v.Clear();
+            assert(Counted::alive == 0 && v.Capacity() == 8);
+            v.EmplaceBack();
+        }
+        assert(Counted::alive == 0);
+    }
+}
+
+void Test30() {
+    {
+        SoAVector<int, double, std::string> v;
+        for (int i = 0; i < 100; ++i) {
+            v.EmplaceBack(i, i * 0.5, std::to_string(i));
+        }
+        assert(v.Size() == 100 && v.Capacity() >= 100);
+        // Каждое поле хранится в отдельном непрерывном столбце
+        const Span<int> ids = v.Column<0>();
+        assert(ids.Size() == 100 && std::accumulate(ids.begin(), ids.end(), 0) == 4950);
+        const Span<const double> scores = std::as_const(v).Column<1>();
+        assert(scores[10] == 5.0 && &scores[1] == &scores[0] + 1);
+
+        auto [id, score, name] = v[42];
+        assert(id == 42 && score == 21.0 && name == "42");
+        id = -1;
+        name += "!";
+        assert(v.Column<0>()[42] == -1 && std::get<2>(v[42]) == "42!");
+
+        // Аргумент ссылается на поле самого вектора в момент переаллокации
+        while (v.Size() < v.Capacity()) {
+            v.PushBack(0, 0.0, "");
+        }
+        const size_t capacity = v.Capacity();
+        v.EmplaceBack(std::get<0>(v[1]), 1.5, std::get<2>(v[42]));
+        assert(v.Capacity() > capacity && std::get<0>(v[v.Size() - 1]) == 1 && std::get<2>(v[v.Size() - 1]) == "42!");
+
+        v.Erase(0);
+        assert(std::get<0>(v[0]) == 1 && std::get<2>(v[40]) == "41" && std::get<2>(v[41]) == "42!");
+        v.Resize(10);
+        assert(v.Size() == 10 && v.Column<2>().Size() == 10);
+        v.Resize(12);
+        assert(std::get<0>(v[11]) == 0 && std::get<2>(v[11]).empty());
+
+        SoAVector<int, double, std::string> copy(v);
+        assert(copy.Size() == 12 && std::get<2>(copy[0]) == "1");
+        SoAVector<int, double, std::string> moved(std::move(copy));
+        assert(moved.Size() == 12 && copy.Size() == 0);
+        moved.Swap(copy);
+        assert(copy.Size() == 12 && moved.Size() == 0);
+        moved = copy;
+        assert(moved.Size() == 12 && std::get<1>(moved[3]) == 2.0);
+        moved.Clear();
+        assert(moved.Size() == 0 && moved.Capacity() >= 12);
+    }
+    {
+        Counted::alive = 0;
+        {
+            SoAVector<std::string, Counted> v;
+            v.Reserve(4);
+            for (int i = 0; i < 4; ++i) {
+                v.EmplaceBack(std::string(30, 'a' + i), Counted{});
+                std::get<1>(v[i]).value = i;
+            }
+            assert(Counted::alive == 4);
+            const std::string* names = v.Column<0>().Data();
+            std::get<1>(v[2]).value = Counted::THROW_ON_COPY;
+            // Копирование столбца Counted выбрасывает исключение, столбец строк ещё не перенесён
+            try {
+                v.EmplaceBack("new", Counted{});
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(v.Size() == 4 && v.Capacity() == 4 && Counted::alive == 4);
+            assert(v.Column<0>().Data() == names && std::get<0>(v[3]) == std::string(30, 'd'));
+            std::get<1>(v[2]).value = 2;
+            v.EmplaceBack("new", Counted{});
+            assert(v.Size() == 5 && Counted::alive == 5 && std::get<1>(v[2]).value == 2);
+
+            // Исключение при создании поля строки уничтожает уже созданные поля
+            Counted bad;
+            bad.value = Counted::THROW_ON_COPY;
+            try {
+                v.EmplaceBack("bad", bad);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(v.Size() == 5 && Counted::alive == 6);
+            v.PopBack();
+            assert(v.Size() == 4 && Counted::alive == 5);
+        }
+        assert(Counted::alive == 0);
+    }
+}
+
+void Test31() {
+    {
+        Vector<int> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(i);
+        }
+        const Span<const int> all = std::as_const(v).AsSpan();
+        assert(all.Data() == v.Data() && all.Size() == 10 && all[9] == 9);
+        const Span<int> middle = v.Subspan(2, 3);
+        middle[0] = 20;
+        assert(v[2] == 20 && middle.Size() == 3 && middle.SizeBytes() == 3 * sizeof(int));
+
+        const int* data = v.Data();
+        const size_t capacity = v.Capacity();
+        ReleasedBuffer<int> buffer = v.Release();
+        assert(buffer.data == data && buffer.size == 10 && buffer.capacity == capacity);
+        assert(v.Size() == 0 && v.Capacity() == 0 && v.Data() == nullptr);
+        v.PushBack(1);
+        assert(v.Size() == 1 && v.Data() != data);
+
+        // Буфер возвращается в вектор без копирования элементов
+        Vector<int> adopted(std::move(buffer));
+        assert(adopted.Data() == data && adopted.Size() == 10 && adopted.Capacity() == capacity);
+        assert(buffer.data == nullptr && adopted[2] == 20);
+        adopted.PushBack(10);
+        assert(adopted.Size() == 11 && adopted[10] == 10);
+    }
+    {
+        // Буфер, изъятый из вектора, освобождается deleter'ом std::unique_ptr
+        Vector<char> bytes(64);
+        std::fill(bytes.begin(), bytes.end(), 'x');
+        ReleasedBuffer<char> buffer = bytes.Release();
+        std::unique_ptr<char[], BufferDeallocator<char>> owner(buffer.data, buffer.deallocator);
+        assert(owner[63] == 'x' && owner.get_deleter().Capacity() == 64);
+    }
+    {
+        // Внешний буфер, выделенный совместимым аллокатором, принимается во владение
+        std::allocator<std::string> alloc;
+        std::string* data = alloc.allocate(8);
+        new (data) std::string("first");
+        new (data + 1) std::string("second");
+        Vector<std::string> v(ADOPT_BUFFER, data, 2, 8);
+        assert(v.Size() == 2 && v.Capacity() == 8 && v[1] == "second");
+        v.EmplaceBack("third");
+        assert(v.Data() == data && v.Size() == 3);
+
+        ReleasedBuffer<std::string> buffer = v.Release();
+        std::destroy_n(buffer.data, buffer.size);
+        buffer.deallocator(buffer.data);
+    }
+    {
+        Vector<int> empty(ADOPT_BUFFER, nullptr, 0, 0);
+        assert(empty.Size() == 0 && empty.Capacity() == 0);
+        ReleasedBuffer<int> buffer = empty.Release();
+        assert(buffer.data == nullptr && buffer.capacity == 0);
+        buffer.deallocator(buffer.data);
+    }
+}
+
+// Проверяет, что action завершает процесс через std::abort. Выполняется в дочернем процессе
+template <typename Action>
+void ExpectCheckFailure([[maybe_unused]] Action action) {
+#if defined(__unix__) || defined(__APPLE__)
+    std::cout.flush();
+    const pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        // Сообщение о нарушении не нужно в выводе тестов
+        std::freopen("/dev/null", "w", stderr);
+        action();
+        _exit(0);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    assert(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+#endif
+}
+
+void Test32() {
+    {
+        Vector<int> v{ 1, 2, 3 };
+        assert(v.At(2) == 3 && std::as_const(v).At(0) == 1);
+        try {
+            v.At(3) = 0;
+            assert(false);
+        }
+        catch (const std::out_of_range&) {
+        }
+        // Без проверяемых итераторов вектор хранит только буфер и размер
+        static_assert(CHECKED_ITERATORS || sizeof(Vector<int>) == sizeof(RawMemory<int>) + sizeof(size_t));
+        static_assert(CHECKED_ITERATORS == !std::is_pointer_v<Vector<int>::iterator>);
+    }
+    {
+        // Действительные итераторы переживают добавление без переаллокации
+        Vector<std::string> v;
+        v.Reserve(4);
+        v.PushBack("a");
+        v.PushBack("b");
+        auto it = v.begin();
+        v.PushBack("c");
+        assert(*it == "a" && it[2] == "c");
+        Vector<std::string>::const_iterator cit = it;
+        assert(cit == v.cbegin() && v.end() - cit == 3);
+        assert(std::count(v.begin(), v.end(), "b") == 1);
+        it = v.Erase(v.begin() + 1);
+        assert(*it == "c" && v.Size() == 2);
+    }
+    if constexpr (HARDENED_CHECKS) {
+        ExpectCheckFailure([] {
+            Vector<int> v(3);
+            v[3] = 1;
+        });
+        ExpectCheckFailure([] {
+            Vector<int> v;
+            v.PopBack();
+        });
+    }
+    if constexpr (CHECKED_ITERATORS) {
+        ExpectCheckFailure([] {
+            Vector<int> v{ 1, 2 };
+            auto it = v.begin();
+            v.Reserve(100);
+            [[maybe_unused]] const int x = *it;
+        });
+        ExpectCheckFailure([] {
+            Vector<int> v{ 1, 2, 3 };
+            auto it = v.begin() + 2;
+            v.Erase(v.begin());
+            ++it;
+        });
+        ExpectCheckFailure([] {
+            Vector<int> v{ 1, 2, 3 };
+            v.Erase(v.end());
+        });
+        ExpectCheckFailure([] {
+            Vector<int> a{ 1 };
+            Vector<int> b{ 2 };
+            [[maybe_unused]] const bool same = a.begin() == b.begin();
+        });
+        ExpectCheckFailure([] {
+            Vector<int> v{ 1 };
+            [[maybe_unused]] auto it = v.end() + 1;
+        });
+    }
+}
+
+void Test33() {
+    // Исключение при сдвиге хвоста Emplace не оставляет неучтённого объекта за последним элементом
+    {
+        Vector<ThrowingAssign> v;
+        v.Reserve(8);
+        v.EmplaceBack(1);
+        v.EmplaceBack(Counted::THROW_ON_COPY);
+        v.EmplaceBack(3);
+        try {
+            v.Emplace(v.begin(), 0);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 3 && ThrowingAssign::alive == 3);
+        try {
+            const ThrowingAssign value(5);
+            v.Insert(v.begin() + 1, value);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 3 && ThrowingAssign::alive == 3);
+    }
+    assert(ThrowingAssign::alive == 0);
+    // То же для SmallVector при вставке во встроенный буфер
+    {
+        SmallVector<ThrowingAssign, 8> v;
+        v.EmplaceBack(1);
+        v.EmplaceBack(Counted::THROW_ON_COPY);
+        v.EmplaceBack(3);
+        try {
+            v.Emplace(v.begin(), 0);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 3 && ThrowingAssign::alive == 3);
+    }
+    assert(ThrowingAssign::alive == 0);
+}
+
+void Test34() {
+    // Поиск без ветвлений совпадает с std::lower_bound на всех позициях
+    {
+        std::vector<int> keys;
+        for (int n = 0; n <= 33; ++n) {
+            for (int key = -1; key <= 2 * n + 1; ++key) {
+                const size_t expected = static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+                assert(detail::BranchlessLowerBound(keys.data(), keys.size(), key, std::less<int>()) == expected);
+            }
+            keys.push_back(2 * n + 1);
+        }
+    }
+    // FlatSet: вставка, поиск, границы и удаление
+    {
+        FlatSet<int> set{ 5, 1, 3, 3, 9 };
+        assert(set.Size() == 4);
+        assert(std::is_sorted(set.begin(), set.end()));
+        assert(set.Contains(3) && !set.Contains(4));
+        assert(set.Insert(4).second && !set.Insert(4).second);
+        assert(*set.LowerBound(6) == 9 && *set.UpperBound(4) == 5);
+        assert(set.Find(2) == set.end() && *set.Find(5) == 5);
+        assert(set.Erase(1) == 1 && set.Erase(1) == 0);
+        set.Erase(set.Find(9));
+        assert((set == FlatSet<int>{ 3, 4, 5 }));
+        assert(set.Keys().Size() == 3 && set.Keys()[0] == 3);
+
+        FlatSet<int, std::greater<int>> reversed{ 1, 2, 3 };
+        assert(*reversed.begin() == 3);
+    }
+    // InsertBatch сливает отсортированную пачку с одним выделением памяти
+    {
+        FlatSet<int> set;
+        for (int i = 0; i < 100; i += 2) {
+            set.Insert(i);
+        }
+        set.ShrinkToFit();
+        std::vector<int> batch;
+        for (int i = 149; i >= 0; i -= 3) {
+            batch.push_back(i);
+        }
+        batch.push_back(7);
+        std::set<int> oracle(set.begin(), set.end());
+        oracle.insert(batch.begin(), batch.end());
+        set.InsertBatch(batch.begin(), batch.end());
+        assert(set.Size() == oracle.size() && std::equal(set.begin(), set.end(), oracle.begin()));
+        assert(set.Capacity() == set.Size());
+
+        // Ключи больше существующих дописываются в конец
+        const std::vector<int> tail{ 300, 200, 250 };
+        set.InsertBatch(tail.begin(), tail.end());
+        assert(set.Size() == oracle.size() + 3 && *(set.end() - 1) == 300);
+        set.Reserve(1000);
+        assert(set.Capacity() >= 1000);
+        set.Clear();
+        assert(set.Empty());
+    }
+    // Ключи и строки перемещаются при слиянии
+    {
+        FlatSet<std::string> words{ "pear", "apple" };
+        const std::vector<std::string> more{ "fig", "apple", "zucchini" };
+        words.InsertBatch(more.begin(), more.end());
+        const std::vector<std::string> expected{ "apple", "fig", "pear", "zucchini" };
+        assert(std::equal(words.begin(), words.end(), expected.begin(), expected.end()));
+    }
+    // Исключение при слиянии оставляет карту прежней, хотя ключи перемещаются без исключений
+    {
+        FlatMap<std::string, CopyCountdown> map;
+        for (int i = 0; i < 8; ++i) {
+            map.TryEmplace(std::to_string(2 * i), i);
+        }
+        const std::vector<std::pair<std::string, CopyCountdown>> batch{
+            { "1", CopyCountdown(10) }, { "5", CopyCountdown(11) }, { "9", CopyCountdown(12) } };
+        bool inserted = false;
+        for (int copies = 0; !inserted; ++copies) {
+            CopyCountdown::copies_left = copies;
+            try {
+                map.InsertBatch(batch.begin(), batch.end());
+                inserted = true;
+            }
+            catch (const std::runtime_error&) {
+                assert(map.Size() == 8);
+                for (int i = 0; i < 8; ++i) {
+                    assert(map.At(std::to_string(2 * i)).value == i);
+                }
+            }
+        }
+        CopyCountdown::copies_left = -1;
+        assert(map.Size() == 11 && map.At("5").value == 11 && map.At("14").value == 7);
+    }
+    // FlatMap: ключи и значения в отдельных массивах
+    {
+        FlatMap<int, std::string> map{ { 2, "two" }, { 1, "one" }, { 2, "deux" } };
+        assert(map.Size() == 2 && map.At(2) == "two");
+        map[3] = "three";
+        map[1] += "!";
+        assert(map.Size() == 3 && map[1] == "one!");
+        assert(!map.Insert({ 3, "trois" }).second && map.At(3) == "three");
+        assert(!map.TryEmplace(1, "uno").second && map.TryEmplace(0, 4, 'z').second);
+        assert(map.At(0) == "zzzz");
+        assert(!map.InsertOrAssign(0, "zero").second && map.At(0) == "zero");
+        assert(map.InsertOrAssign(5, "five").second);
+
+        const std::vector<int> keys{ 0, 1, 2, 3, 5 };
+        assert(std::equal(map.Keys().begin(), map.Keys().end(), keys.begin(), keys.end()));
+        assert(map.Values()[4] == "five");
+
+        auto it = map.Find(2);
+        assert(it != map.end() && it->first == 2 && it->second == "two");
+        (*it).second = "dos";
+        assert(map.At(2) == "dos");
+        assert(map.LowerBound(4)->first == 5 && map.UpperBound(3)->first == 5);
+        assert(map.Find(4) == map.end() && map.Count(5) == 1);
+
+        size_t visited = 0;
+        for (auto [key, value] : map) {
+            assert(key == keys[visited++] && !value.empty());
+        }
+        assert(visited == map.Size());
+
+        assert(map.Erase(3) == 1 && map.Erase(3) == 0);
+        it = map.Erase(map.Find(0));
+        assert(it->first == 1 && map.Size() == 3);
+        try {
+            map.At(42);
+            assert(false);
+        }
+        catch (const std::out_of_range&) {
+        }
+        const auto& cmap = map;
+        assert(cmap.Find(5)->second == "five" && cmap.begin()->first == 1);
+    }
+    // InsertBatch карты совпадает с std::map::insert: существующие значения сохраняются
+    {
+        FlatMap<int, int> map;
+        std::map<int, int> oracle;
+        std::mt19937 rng(29);
+        for (int round = 0; round < 20; ++round) {
+            std::vector<std::pair<int, int>> batch;
+            const int count = static_cast<int>(rng() % 50);
+            for (int i = 0; i < count; ++i) {
+                batch.emplace_back(static_cast<int>(rng() % 500), round * 100 + i);
+            }
+            oracle.insert(batch.begin(), batch.end());
+            if (round % 3 == 0) {
+                for (const auto& [key, value] : batch) {
+                    map.Insert({ key, value });
+                }
+            }
+            else {
+                map.InsertBatch(batch.begin(), batch.end());
+            }
+            assert(map.Size() == oracle.size());
+            assert(std::equal(map.begin(), map.end(), oracle.begin(), [](const auto& lhs, const auto& rhs) {
+                return lhs.first == rhs.first && lhs.second == rhs.second;
+            }));
+        }
+        FlatMap<int, int> copy = map;
+        assert(copy == map);
+        copy[-1] = 0;
+        assert(copy != map);
+        copy.Swap(map);
+        assert(map.Contains(-1) && !copy.Contains(-1));
+        map.ShrinkToFit();
+        assert(map.Capacity() == map.Size());
+    }
+}
+
+void Test35() {
+    using namespace std::literals;
+    // Пул с кражей работы: вложенные группы задач и передача исключений
+    {
+        ThreadPool pool(3);
+        assert(pool.ThreadCount() == 3);
+        std::atomic<int> done{ 0 };
+        {
+            TaskGroup group(pool);
+            for (int i = 0; i < 50; ++i) {
+                group.Run([&pool, &done] {
+                    TaskGroup nested(pool);
+                    for (int j = 0; j < 10; ++j) {
+                        nested.Run([&done] {
+                            done.fetch_add(1, std::memory_order_relaxed);
+                        });
+                    }
+                    nested.Wait();
+                    done.fetch_add(1, std::memory_order_relaxed);
+                });
+            }
+            group.Wait();
+        }
+        assert(done == 50 * 11);
+
+        TaskGroup group(pool);
+        for (int i = 0; i < 10; ++i) {
+            group.Run([i, &done] {
+                if (i == 7) {
+                    throw std::runtime_error("task failed");
+                }
+                done.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        try {
+            group.Wait();
+            assert(false);
+        }
+        catch (const std::runtime_error& e) {
+            assert(e.what() == "task failed"sv);
+        }
+        assert(done == 50 * 11 + 9);
+        group.Wait();
+    }
+
+    SetParallelThreadLimit(4);
+    const size_t SIZE = detail::PARALLEL_MIN_CHUNK * 16 + 123;
+    std::mt19937 rng(35);
+    Vector<int> source(SIZE);
+    for (int& x : source) {
+        x = static_cast<int>(rng() % 100000);
+    }
+
+    // Внутренние границы частей начинаются с кэш-линии
+    {
+        const auto bounds = detail::ChunkBounds(source.Data(), SIZE, detail::AlgorithmChunkCount(SIZE));
+        assert(bounds.size() == 17 && bounds.front() == 0 && bounds.back() == SIZE);
+        for (size_t i = 1; i + 1 < bounds.size(); ++i) {
+            assert(bounds[i - 1] <= bounds[i]);
+            assert(reinterpret_cast<uintptr_t>(source.Data() + bounds[i]) % detail::CACHE_LINE_SIZE == 0);
+        }
+    }
+    // Sort совпадает с std::sort
+    {
+        Vector<int> v = source;
+        std::vector<int> expected(source.begin(), source.end());
+        ParallelSort(v);
+        std::sort(expected.begin(), expected.end());
+        assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+        ParallelSort(v, std::greater<>());
+        assert(std::is_sorted(v.begin(), v.end(), std::greater<>()));
+
+        Vector<int> small{ 3, 1, 2 };
+        ParallelSort(small);
+        assert((small == Vector<int>{ 1, 2, 3 }));
+    }
+    // Transform, ForEach и Reduce
+    {
+        Vector<long long> squares(SIZE);
+        ParallelTransform(source, squares, [](int x) {
+            return static_cast<long long>(x) * x;
+        });
+        for (size_t i = 0; i < SIZE; i += 997) {
+            assert(squares[i] == static_cast<long long>(source[i]) * source[i]);
+        }
+        const long long expected = std::accumulate(squares.begin(), squares.end(), 0LL);
+        assert(ParallelReduce(squares, 0LL) == expected);
+        assert(ParallelReduce(squares, 5LL, [](long long a, long long b) {
+            return std::max(a, b);
+        }) == *std::max_element(squares.begin(), squares.end()));
+
+        Vector<int> v = source;
+        ParallelForEach(v, [](int& x) {
+            x += 1;
+        });
+        ParallelTransform(v.AsSpan(), v.AsSpan(), [](int x) {
+            return x * 2;
+        });
+        for (size_t i = 0; i < SIZE; i += 997) {
+            assert(v[i] == (source[i] + 1) * 2);
+        }
+    }
+    // Partition переставляет элементы, сохраняя их набор
+    {
+        Vector<int> v = source;
+        const auto is_even = [](int x) {
+            return x % 2 == 0;
+        };
+        const auto boundary = ParallelPartition(v, is_even);
+        assert(std::all_of(v.begin(), boundary, is_even) && std::none_of(boundary, v.end(), is_even));
+        assert(static_cast<size_t>(boundary - v.begin()) == static_cast<size_t>(std::count_if(source.begin(), source.end(), is_even)));
+        std::vector<int> sorted(v.begin(), v.end());
+        std::vector<int> expected(source.begin(), source.end());
+        std::sort(sorted.begin(), sorted.end());
+        std::sort(expected.begin(), expected.end());
+        assert(sorted == expected);
+
+        Vector<std::string> words(detail::PARALLEL_MIN_CHUNK * 4);
+        for (size_t i = 0; i < words.Size(); ++i) {
+            words[i] = std::to_string(i) + " a long string that does not fit in SSO";
+        }
+        const auto words_boundary = ParallelPartition(words, [](const std::string& word) {
+            return word[0] == '1';
+        });
+        assert(std::all_of(words.begin(), words_boundary, [](const std::string& word) {
+            return word[0] == '1';
+        }));
+        assert(std::none_of(words_boundary, words.end(), [](const std::string& word) {
+            return word[0] == '1';
+        }));
+        assert(std::count_if(words.begin(), words.end(), [](const std::string& word) {
+            return word.size() > 30;
+        }) == static_cast<std::ptrdiff_t>(words.Size()));
+    }
+    // Исключение из функции пользователя выбрасывается после завершения всех частей
+    {
+        Vector<int> v = source;
+        std::atomic<size_t> visited{ 0 };
+        try {
+            ParallelForEach(v, [&visited](int& x) {
+                if (visited.fetch_add(1, std::memory_order_relaxed) == SIZE / 2) {
+                    throw std::runtime_error("element failed");
+                }
+                x = -1;
+            });
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
     }
+    SetParallelThreadLimit(0);
 }
 
 int main() {
@@ -655,9 +2899,38 @@ int main() {
         Test4();
         Test5();
         Test6();
-        Benchmark();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
+        Test27();
+        Test28();
+        Test29();
+        Test30();
+        Test31();
+        Test32();
+        Test33();
+        Test34();
+        Test35();
     }
     catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
+        return 1;
     }
 }
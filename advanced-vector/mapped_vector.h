@@ -0,0 +1,515 @@
+#pragma once
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "growth_policy.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ADVANCED_VECTOR_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//     MappedVector
+enum class MapMode {
+    //  ,  :      
+    READ_ONLY,
+    //          .   
+    //    
+    COPY_ON_WRITE,
+    //    ,   .   
+    READ_WRITE,
+};
+
+//   MappedVector.          
+struct MappedVectorHeader {
+    static constexpr char MAGIC[8] = { 'A', 'V', 'E', 'C', 'T', 'O', 'R', '\0' };
+    static constexpr uint32_t VERSION = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t element_size;
+    uint64_t element_alignment;
+    uint64_t size;
+    uint64_t capacity;
+    unsigned char reserved[16];
+};
+static_assert(sizeof(MappedVectorHeader) == 64, "Header layout must not change");
+
+//    ,      .
+//       ,      ,
+//       .   
+//  std::system_error,    std::runtime_error,
+//  ,    ,  std::logic_error
+template <typename T, typename GrowthPolicy = DoublingGrowth>
+class MappedVector {
+    static_assert(std::is_trivially_copyable_v<T>, "MappedVector stores only trivially copyable types");
+    static_assert(alignof(T) <= sizeof(MappedVectorHeader), "Element alignment is too large");
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    MappedVector() = default;
+    MappedVector(const std::string& path, MapMode mode);
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& other) noexcept;
+    MappedVector& operator=(MappedVector&& rhs) noexcept;
+
+    ~MappedVector();
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    size_t Size() const noexcept;
+    size_t Capacity() const noexcept;
+    MapMode GetMode() const noexcept;
+    bool IsOpen() const noexcept;
+
+    //   READ_WRITE  
+    void Reserve(size_t new_capacity);
+    //    
+    void Resize(size_t new_size);
+    void PushBack(const T& value);
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+    void PopBack() noexcept;
+    void Clear() noexcept;
+
+    const T& operator[](size_t index) const noexcept;
+    //   READ_ONLY    ,   
+    T& operator[](size_t index) noexcept;
+
+    //      ( READ_WRITE)
+    void Flush();
+    //  .    READ_WRITE    
+    void Close() noexcept;
+
+    void Swap(MappedVector& other) noexcept;
+
+private:
+    static constexpr size_t DATA_OFFSET = sizeof(MappedVectorHeader);
+
+    //       capacity
+    static size_t MappedBytes(size_t capacity);
+
+    [[noreturn]] static void ThrowSystemError(const char* what);
+
+    MappedVectorHeader& Header() noexcept;
+    T* Data() noexcept;
+    const T* Data() const noexcept;
+
+    void Open(const std::string& path);
+    void ValidateHeader(size_t file_bytes) const;
+    void RequireWritable() const;
+    //    new_capacity    
+    void Remap(size_t new_capacity);
+    void SetSize(size_t size) noexcept;
+
+    int fd_ = -1;
+    MapMode mode_ = MapMode::READ_ONLY;
+    unsigned char* base_ = nullptr;
+    size_t mapped_bytes_ = 0;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
+
+template<typename T, typename GrowthPolicy>
+inline MappedVector<T, GrowthPolicy>::MappedVector(const std::string& path, MapMode mode)
+    : mode_(mode)
+{
+    try
+    {
+        Open(path);
+    }
+    catch (...)
+    {
+        Close();
+        throw;
+    }
+}
+
+template<typename T, typename GrowthPolicy>
+inline MappedVector<T, GrowthPolicy>::MappedVector(MappedVector&& other) noexcept
+{
+    Swap(other);
+}
+
+template<typename T, typename GrowthPolicy>
+inline MappedVector<T, GrowthPolicy>& MappedVector<T, GrowthPolicy>::operator=(MappedVector&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        Close();
+        Swap(rhs);
+    }
+    return *this;
+}
+
+template<typename T, typename GrowthPolicy>
+inline MappedVector<T, GrowthPolicy>::~MappedVector()
+{
+    Close();
+}
+
+template<typename T, typename GrowthPolicy>
+inline typename MappedVector<T, GrowthPolicy>::iterator MappedVector<T, GrowthPolicy>::begin() noexcept
+{
+    return Data();
+}
+
+template<typename T, typename GrowthPolicy>
+inline typename MappedVector<T, GrowthPolicy>::iterator MappedVector<T, GrowthPolicy>::end() noexcept
+{
+    return Data() + size_;
+}
+
+template<typename T, typename GrowthPolicy>
+inline typename MappedVector<T, GrowthPolicy>::const_iterator MappedVector<T, GrowthPolicy>::begin() const noexcept
+{
+    return Data();
+}
+
+template<typename T, typename GrowthPolicy>
+inline typename MappedVector<T, GrowthPolicy>::const_iterator MappedVector<T, GrowthPolicy>::end() const noexcept
+{
+    return Data() + size_;
+}
+
+template<typename T, typename GrowthPolicy>
+inline typename MappedVector<T, GrowthPolicy>::const_iterator MappedVector<T, GrowthPolicy>::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<typename T, typename GrowthPolicy>
+inline typename MappedVector<T, GrowthPolicy>::const_iterator MappedVector<T, GrowthPolicy>::cend() const noexcept
+{
+    return end();
+}
+
+template<typename T, typename GrowthPolicy>
+inline size_t MappedVector<T, GrowthPolicy>::Size() const noexcept
+{
+    return size_;
+}
+
+template<typename T, typename GrowthPolicy>
+inline size_t MappedVector<T, GrowthPolicy>::Capacity() const noexcept
+{
+    return capacity_;
+}
+
+template<typename T, typename GrowthPolicy>
+inline MapMode MappedVector<T, GrowthPolicy>::GetMode() const noexcept
+{
+    return mode_;
+}
+
+template<typename T, typename GrowthPolicy>
+inline bool MappedVector<T, GrowthPolicy>::IsOpen() const noexcept
+{
+    return base_ != nullptr;
+}
+
+template<typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::Reserve(size_t new_capacity)
+{
+    RequireWritable();
+    if (new_capacity > capacity_)
+    {
+        Remap(new_capacity);
+    }
+}
+
+template<typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::Resize(size_t new_size)
+{
+    RequireWritable();
+    if (new_size > size_)
+    {
+        Reserve(new_size);
+        std::memset(static_cast<void*>(Data() + size_), 0, (new_size - size_) * sizeof(T));
+    }
+    SetSize(new_size);
+}
+
+template<typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::PushBack(const T& value)
+{
+    EmplaceBack(value);
+}
+
+template<typename T, typename GrowthPolicy>
+template<typename... Args>
+inline T& MappedVector<T, GrowthPolicy>::EmplaceBack(Args&&... args)
+{
+    RequireWritable();
+    //     ,     
+    const T value(std::forward<Args>(args)...);
+    if (size_ == capacity_)
+    {
+        Remap(GrowthPolicy::NextCapacity(capacity_, size_ + 1, sizeof(T)));
+    }
+    std::memcpy(static_cast<void*>(Data() + size_), static_cast<const void*>(&value), sizeof(T));
+    SetSize(size_ + 1);
+    return Data()[size_ - 1];
+}
+
+template<typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::PopBack() noexcept
+{
+    assert(size_ != 0 && mode_ != MapMode::READ_ONLY);
+    SetSize(size_ - 1);
+}
+
+template<typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::Clear() noexcept
+{
+    assert(mode_ != MapMode::READ_ONLY);
+    SetSize(0);
+}
+
+template<typename T, typename GrowthPolicy>
+inline const T& MappedVector<T, GrowthPolicy>::operator[](size_t index) const noexcept
+{
+    assert(index < size_);
+    return Data()[index];
+}
+
+template<typename T, typename GrowthPolicy>
+inline T& MappedVector<T, GrowthPolicy>::operator[](size_t index) noexcept
+{
+    assert(index < size_);
+    return Data()[index];
+}
+
+template<typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::Flush()
+{
+#if defined(ADVANCED_VECTOR_HAS_MMAP)
+    if (mode_ == MapMode::READ_WRITE && base_ != nullptr && msync(base_, mapped_bytes_, MS_SYNC) != 0)
+    {
+        ThrowSystemError("msync");
+    }
+#endif
+}
+
+template<typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::Close() noexcept
+{
+#if defined(ADVANCED_VECTOR_HAS_MMAP)
+    if (base_ != nullptr)
+    {
+        munmap(base_, mapped_bytes_);
+    }
+    if (fd_ != -1)
+    {
+        close(fd_);
+    }
+#endif
+    fd_ = -1;
+    base_ = nullptr;
+    mapped_bytes_ = 0;
+    size_ = 0;
+    capacity_ = 0;
+}
+
+template<typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::Swap(MappedVector& other) noexcept
+{
+    std::swap(fd_, other.fd_);
+    std::swap(mode_, other.mode_);
+    std::swap(base_, other.base_);
+    std::swap(mapped_bytes_, other.mapped_bytes_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+}
+
+template<typename T, typename GrowthPolicy>
+inline size_t MappedVector<T, GrowthPolicy>::MappedBytes(size_t capacity)
+{
+    if (capacity > (static_cast<size_t>(-1) - DATA_OFFSET) / sizeof(T))
+    {
+        throw std::length_error("MappedVector capacity is too large");
+    }
+    return DATA_OFFSET + capacity * sizeof(T);
+}
+
+template<typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::ThrowSystemError(const char* what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+template<typename T, typename GrowthPolicy>
+inline MappedVectorHeader& MappedVector<T, GrowthPolicy>::Header() noexcept
+{
+    return *reinterpret_cast<MappedVectorHeader*>(base_);
+}
+
+template<typename T, typename GrowthPolicy>
+inline T* MappedVector<T, GrowthPolicy>::Data() noexcept
+{
+    return base_ != nullptr ? reinterpret_cast<T*>(base_ + DATA_OFFSET) : nullptr;
+}
+
+template<typename T, typename GrowthPolicy>
+inline const T* MappedVector<T, GrowthPolicy>::Data() const noexcept
+{
+    return base_ != nullptr ? reinterpret_cast<const T*>(base_ + DATA_OFFSET) : nullptr;
+}
+
+template<typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::Open(const std::string& path)
+{
+#if defined(ADVANCED_VECTOR_HAS_MMAP)
+    const int flags = mode_ == MapMode::READ_WRITE ? O_RDWR | O_CREAT : O_RDONLY;
+    fd_ = open(path.c_str(), flags, 0644);
+    if (fd_ == -1)
+    {
+        ThrowSystemError("open");
+    }
+    struct stat info;
+    if (fstat(fd_, &info) != 0)
+    {
+        ThrowSystemError("fstat");
+    }
+    size_t file_bytes = static_cast<size_t>(info.st_size);
+    const bool created = file_bytes == 0 && mode_ == MapMode::READ_WRITE;
+    if (created)
+    {
+        file_bytes = MappedBytes(0);
+        if (ftruncate(fd_, static_cast<off_t>(file_bytes)) != 0)
+        {
+            ThrowSystemError("ftruncate");
+        }
+    }
+    if (file_bytes < DATA_OFFSET)
+    {
+        throw std::runtime_error("File is too small for a MappedVector header");
+    }
+    const int protection = mode_ == MapMode::READ_ONLY ? PROT_READ : PROT_READ | PROT_WRITE;
+    const int sharing = mode_ == MapMode::COPY_ON_WRITE ? MAP_PRIVATE : MAP_SHARED;
+    void* base = mmap(nullptr, file_bytes, protection, sharing, fd_, 0);
+    if (base == MAP_FAILED)
+    {
+        ThrowSystemError("mmap");
+    }
+    base_ = static_cast<unsigned char*>(base);
+    mapped_bytes_ = file_bytes;
+    if (created)
+    {
+        MappedVectorHeader& header = Header();
+        std::memcpy(header.magic, MappedVectorHeader::MAGIC, sizeof(header.magic));
+        header.version = MappedVectorHeader::VERSION;
+        header.header_size = sizeof(MappedVectorHeader);
+        header.element_size = sizeof(T);
+        header.element_alignment = alignof(T);
+        header.size = 0;
+        header.capacity = 0;
+    }
+    ValidateHeader(file_bytes);
+    size_ = static_cast<size_t>(Header().size);
+    capacity_ = static_cast<size_t>(Header().capacity);
+#else
+    (void)path;
+    throw std::system_error(std::make_error_code(std::errc::function_not_supported), "MappedVector");
+#endif
+}
+
+template<typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::ValidateHeader(size_t file_bytes) const
+{
+    const MappedVectorHeader& header = *reinterpret_cast<const MappedVectorHeader*>(base_);
+    if (std::memcmp(header.magic, MappedVectorHeader::MAGIC, sizeof(header.magic)) != 0)
+    {
+        throw std::runtime_error("File is not a MappedVector");
+    }
+    if (header.version != MappedVectorHeader::VERSION || header.header_size != sizeof(MappedVectorHeader))
+    {
+        throw std::runtime_error("Unsupported MappedVector file version");
+    }
+    if (header.element_size != sizeof(T) || header.element_alignment != alignof(T))
+    {
+        throw std::runtime_error("MappedVector file holds elements of another type");
+    }
+    if (header.size > header.capacity || header.capacity > (file_bytes - DATA_OFFSET) / sizeof(T))
+    {
+        throw std::runtime_error("MappedVector file is truncated");
+    }
+}
+
+template<typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::RequireWritable() const
+{
+    if (base_ == nullptr || mode_ == MapMode::READ_ONLY)
+    {
+        throw std::logic_error("MappedVector is not opened for writing");
+    }
+}
+
+template<typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::Remap(size_t new_capacity)
+{
+#if defined(ADVANCED_VECTOR_HAS_MMAP)
+    assert(base_ != nullptr && new_capacity >= size_);
+    const size_t new_bytes = MappedBytes(new_capacity);
+    void* base = MAP_FAILED;
+    if (mode_ == MapMode::READ_WRITE)
+    {
+        //      ,       
+        if (new_bytes > mapped_bytes_ && ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0)
+        {
+            ThrowSystemError("ftruncate");
+        }
+        base = mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (base == MAP_FAILED)
+        {
+            ThrowSystemError("mmap");
+        }
+    }
+    else
+    {
+        base = mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED)
+        {
+            ThrowSystemError("mmap");
+        }
+        std::memcpy(base, base_, DATA_OFFSET + size_ * sizeof(T));
+    }
+    munmap(base_, mapped_bytes_);
+    base_ = static_cast<unsigned char*>(base);
+    mapped_bytes_ = new_bytes;
+    capacity_ = new_capacity;
+    Header().capacity = new_capacity;
+#else
+    (void)new_capacity;
+#endif
+}
+
+template<typename T, typename GrowthPolicy>
+inline void MappedVector<T, GrowthPolicy>::SetSize(size_t size) noexcept
+{
+    size_ = size;
+    Header().size = size;
+}
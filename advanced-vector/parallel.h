@@ -0,0 +1,162 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "relocation.h"
+#include "thread_pool.h"
+
+//   :      
+struct ParallelTag {
+};
+inline constexpr ParallelTag PARALLEL{};
+
+//    T      .    
+//        .  :
+//     template <> struct ParallelRelocation<Row> : std::true_type {};
+template <typename T>
+struct ParallelRelocation : std::false_type {
+};
+
+template <typename T>
+inline constexpr bool ParallelRelocationV = ParallelRelocation<T>::value;
+
+namespace detail {
+
+    //   ,      
+    inline constexpr size_t PARALLEL_MIN_CHUNK = size_t(1) << 14;
+
+    //     ; 0  std::thread::hardware_concurrency()
+    inline std::atomic<unsigned> parallel_thread_limit{ 0 };
+
+    //  ,     ,   
+    inline size_t ParallelThreadCount() noexcept {
+        const unsigned threads = parallel_thread_limit.load(std::memory_order_relaxed);
+        return threads != 0 ? threads : std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    inline size_t ParallelChunkCount(size_t n) noexcept {
+        return std::max<size_t>(1, std::min<size_t>(ParallelThreadCount(), n / PARALLEL_MIN_CHUNK));
+    }
+
+    //   index  chunks    [0, n)
+    inline size_t ChunkBegin(size_t n, size_t chunks, size_t index) noexcept {
+        return n / chunks * index + std::min(index, n % chunks);
+    }
+
+    //  fn(index, first, last)    chunks   [0, n)  
+    //   .    ThreadPool::Default(),   
+    //        .    
+    //   ,       . fn    
+    template <typename ChunkFn>
+    void RunChunks(size_t n, size_t chunks, ChunkFn& fn) noexcept {
+        TaskGroup group;
+        for (size_t i = 1; i < chunks; ++i) {
+            const size_t first = ChunkBegin(n, chunks, i);
+            const size_t last = ChunkBegin(n, chunks, i + 1);
+            try {
+                group.Run([&fn, i, first, last] {
+                    fn(i, first, last);
+                });
+            }
+            catch (...) {
+                fn(i, first, last);
+            }
+        }
+        fn(0, 0, ChunkBegin(n, chunks, 1));
+        group.Wait();
+    }
+
+    //  n       dest. construct(first, last)  
+    // [first, last)         .     
+    //  ,    ,    
+    template <typename T, typename Construct>
+    void ParallelUninitialized(T* dest, size_t n, Construct construct) {
+        const size_t chunks = ParallelChunkCount(n);
+        if (chunks == 1) {
+            construct(size_t(0), n);
+            return;
+        }
+        std::vector<std::exception_ptr> errors(chunks);
+        auto run = [&](size_t index, size_t first, size_t last) noexcept {
+            try {
+                construct(first, last);
+            }
+            catch (...) {
+                errors[index] = std::current_exception();
+            }
+        };
+        RunChunks(n, chunks, run);
+        const auto failed = std::find_if(errors.begin(), errors.end(), [](const std::exception_ptr& error) {
+            return error != nullptr;
+        });
+        if (failed == errors.end()) {
+            return;
+        }
+        for (size_t i = 0; i < chunks; ++i) {
+            if (errors[i] == nullptr) {
+                const size_t first = ChunkBegin(n, chunks, i);
+                std::destroy_n(dest + first, ChunkBegin(n, chunks, i + 1) - first);
+            }
+        }
+        std::rethrow_exception(*failed);
+    }
+
+    //  n    buf,    
+    template <typename T>
+    void ParallelDestroyN(T* buf, size_t n) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            const size_t chunks = ParallelChunkCount(n);
+            if (chunks == 1) {
+                std::destroy_n(buf, n);
+                return;
+            }
+            auto run = [buf](size_t, size_t first, size_t last) noexcept {
+                std::destroy_n(buf + first, last - first);
+            };
+            RunChunks(n, chunks, run);
+        }
+    }
+
+    //  UninitializedRelocateN,    ParallelRelocation<T>   
+    //   .    -   ,  
+    //  ,     
+    template <typename T>
+    void ParallelUninitializedRelocateN(T* from, size_t n, T* to) {
+        if constexpr (ParallelRelocationV<T> && !IsTriviallyRelocatableV<T>) {
+            ParallelUninitialized(to, n, [from, to](size_t first, size_t last) {
+                UninitializedRelocateN(from + first, last - first, to + first);
+            });
+        }
+        else {
+            UninitializedRelocateN(from, n, to);
+        }
+    }
+
+    template <typename T>
+    void ParallelDestroyRelocatedN(T* from, size_t n) noexcept {
+        if constexpr (ParallelRelocationV<T> && !IsTriviallyRelocatableV<T>) {
+            ParallelDestroyN(from, n);
+        }
+        else {
+            DestroyRelocatedN(from, n);
+        }
+    }
+
+    template <typename T>
+    void ParallelRelocateN(T* from, size_t n, T* to) {
+        ParallelUninitializedRelocateN(from, n, to);
+        ParallelDestroyRelocatedN(from, n);
+    }
+
+}  // namespace detail
+
+//   ,   . 0  
+inline void SetParallelThreadLimit(unsigned threads) noexcept {
+    detail::parallel_thread_limit.store(threads, std::memory_order_relaxed);
+}
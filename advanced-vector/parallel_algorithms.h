@@ -0,0 +1,275 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parallel.h"
+#include "span.h"
+#include "thread_pool.h"
+#include "vector.h"
+
+//     : Span  Vector .
+//           (. SetParallelThreadLimit),
+//    ThreadPool::Default();     .
+//      -,        .
+//   detail::PARALLEL_MIN_CHUNK       .
+//    std::execution::par,      
+// :        
+
+namespace detail {
+
+    inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+    //  ,  ,      .
+    //      ,    
+    inline constexpr size_t CHUNKS_PER_THREAD = 4;
+
+    inline size_t AlgorithmChunkCount(size_t n) noexcept {
+        const size_t threads = ParallelThreadCount();
+        if (threads == 1) {
+            return 1;
+        }
+        return std::max<size_t>(1, std::min<size_t>(threads * CHUNKS_PER_THREAD, n / PARALLEL_MIN_CHUNK));
+    }
+
+    //  chunks   data[0, n): bounds[i]    i, bounds[chunks] == n.
+    //       ,  -,
+    //   T   -
+    template <typename T>
+    std::vector<size_t> ChunkBounds(const T* data, size_t n, size_t chunks) {
+        std::vector<size_t> bounds(chunks + 1);
+        for (size_t i = 0; i <= chunks; ++i) {
+            size_t bound = ChunkBegin(n, chunks, i);
+            if constexpr (CACHE_LINE_SIZE % sizeof(T) == 0) {
+                if (i != 0 && i != chunks) {
+                    const size_t offset = reinterpret_cast<uintptr_t>(data + bound) % CACHE_LINE_SIZE;
+                    if (offset % sizeof(T) == 0) {
+                        bound += (CACHE_LINE_SIZE - offset) % CACHE_LINE_SIZE / sizeof(T);
+                    }
+                }
+            }
+            bounds[i] = std::min(std::max(bound, bounds[i == 0 ? 0 : i - 1]), n);
+        }
+        return bounds;
+    }
+
+    //  fn(index, first, last)    bounds    .
+    //      .   fn  
+    //   
+    template <typename ChunkFn>
+    void RunBoundedChunks(const std::vector<size_t>& bounds, ChunkFn& fn) {
+        const size_t chunks = bounds.size() - 1;
+        if (chunks == 1) {
+            fn(0, bounds[0], bounds[1]);
+            return;
+        }
+        TaskGroup group;
+        std::exception_ptr error;
+        try {
+            for (size_t i = 1; i < chunks; ++i) {
+                group.Run([&fn, &bounds, i] {
+                    fn(i, bounds[i], bounds[i + 1]);
+                });
+            }
+            fn(0, bounds[0], bounds[1]);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        group.Wait();
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    //     ,    
+    template <typename T, typename Compare>
+    void MergeSortedChunks(T* data, std::vector<size_t> bounds, const Compare& comp) {
+        while (bounds.size() > 2) {
+            const size_t pairs = (bounds.size() - 1) / 2;
+            std::vector<size_t> merged;
+            merged.reserve(pairs + 2);
+            for (size_t i = 0; i + 2 < bounds.size(); i += 2) {
+                merged.push_back(bounds[i]);
+            }
+            if ((bounds.size() - 1) % 2 != 0) {
+                merged.push_back(bounds[bounds.size() - 2]);
+            }
+            merged.push_back(bounds.back());
+
+            TaskGroup group;
+            std::exception_ptr error;
+            try {
+                for (size_t pair = 1; pair < pairs; ++pair) {
+                    group.Run([data, &bounds, &comp, pair] {
+                        std::inplace_merge(data + bounds[2 * pair], data + bounds[2 * pair + 1], data + bounds[2 * pair + 2], comp);
+                    });
+                }
+                std::inplace_merge(data + bounds[0], data + bounds[1], data + bounds[2], comp);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+            group.Wait();
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            bounds = std::move(merged);
+        }
+    }
+
+}  // namespace detail
+
+//  fn(elem)    range
+template <typename T, typename Fn>
+void ParallelForEach(Span<T> range, Fn fn) {
+    const auto bounds = detail::ChunkBounds(range.Data(), range.Size(), detail::AlgorithmChunkCount(range.Size()));
+    auto run = [&range, &fn](size_t, size_t first, size_t last) {
+        std::for_each(range.begin() + first, range.begin() + last, fn);
+    };
+    detail::RunBoundedChunks(bounds, run);
+}
+
+//  op(in[i])  out[i]. out   in.Size()      in
+template <typename T, typename U, typename UnaryOp>
+void ParallelTransform(Span<T> in, Span<U> out, UnaryOp op) {
+    assert(out.Size() >= in.Size());
+    const auto bounds = detail::ChunkBounds(out.Data(), in.Size(), detail::AlgorithmChunkCount(in.Size()));
+    auto run = [&in, &out, &op](size_t, size_t first, size_t last) {
+        std::transform(in.begin() + first, in.begin() + last, out.begin() + first, op);
+    };
+    detail::RunBoundedChunks(bounds, run);
+}
+
+//  init   range  op.   ,  op 
+//    ,   std::reduce
+template <typename T, typename U, typename BinaryOp = std::plus<>>
+U ParallelReduce(Span<T> range, U init, BinaryOp op = BinaryOp()) {
+    const size_t chunks = detail::AlgorithmChunkCount(range.Size());
+    if (chunks == 1) {
+        return std::accumulate(range.begin(), range.end(), std::move(init), op);
+    }
+    const auto bounds = detail::ChunkBounds(range.Data(), range.Size(), chunks);
+    //     -,       
+    struct alignas(detail::CACHE_LINE_SIZE) Partial {
+        std::optional<U> value;
+    };
+    std::vector<Partial> partials(chunks);
+    auto run = [&range, &op, &partials](size_t index, size_t first, size_t last) {
+        if (first == last) {
+            return;
+        }
+        U value = range[first];
+        for (size_t i = first + 1; i < last; ++i) {
+            value = op(std::move(value), range[i]);
+        }
+        partials[index].value.emplace(std::move(value));
+    };
+    detail::RunBoundedChunks(bounds, run);
+    for (Partial& partial : partials) {
+        if (partial.value) {
+            init = op(std::move(init), std::move(*partial.value));
+        }
+    }
+    return init;
+}
+
+//  range:   ,   ,  .
+//   std::sort,     
+template <typename T, typename Compare = std::less<>>
+void ParallelSort(Span<T> range, Compare comp = Compare()) {
+    const size_t chunks = detail::AlgorithmChunkCount(range.Size());
+    if (chunks == 1) {
+        std::sort(range.begin(), range.end(), comp);
+        return;
+    }
+    const auto bounds = detail::ChunkBounds(range.Data(), range.Size(), chunks);
+    auto run = [&range, &comp](size_t, size_t first, size_t last) {
+        std::sort(range.begin() + first, range.begin() + last, comp);
+    };
+    detail::RunBoundedChunks(bounds, run);
+    detail::MergeSortedChunks(range.Data(), bounds, comp);
+}
+
+//   range ,   pred  ,  
+//      .   ,  
+//    .       std::partition
+template <typename T, typename Predicate>
+T* ParallelPartition(Span<T> range, Predicate pred) {
+    if constexpr (!std::is_nothrow_move_constructible_v<T> || !std::is_nothrow_move_assignable_v<T>) {
+        return std::partition(range.begin(), range.end(), pred);
+    }
+    else {
+        const size_t chunks = detail::AlgorithmChunkCount(range.Size());
+        if (chunks == 1) {
+            return std::partition(range.begin(), range.end(), pred);
+        }
+        const auto bounds = detail::ChunkBounds(range.Data(), range.Size(), chunks);
+        //    :    range  
+        RawMemory<T> buffer(range.Size());
+        std::vector<size_t> mids(chunks);
+        auto partition = [&range, &pred, &mids](size_t index, size_t first, size_t last) {
+            mids[index] = static_cast<size_t>(std::partition(range.begin() + first, range.begin() + last, pred) - range.begin());
+        };
+        detail::RunBoundedChunks(bounds, partition);
+
+        //       
+        std::vector<size_t> true_offsets(chunks + 1, 0);
+        for (size_t i = 0; i < chunks; ++i) {
+            true_offsets[i + 1] = true_offsets[i] + (mids[i] - bounds[i]);
+        }
+        const size_t boundary = true_offsets[chunks];
+
+        T* const data = range.Data();
+        T* const temp = buffer.GetAddress();
+        auto gather = [&](size_t index, size_t first, size_t last) noexcept {
+            const size_t false_offset = boundary + (first - true_offsets[index]);
+            std::uninitialized_move(data + first, data + mids[index], temp + true_offsets[index]);
+            std::uninitialized_move(data + mids[index], data + last, temp + false_offset);
+        };
+        detail::RunBoundedChunks(bounds, gather);
+        auto scatter = [data, temp](size_t, size_t first, size_t last) noexcept {
+            std::move(temp + first, temp + last, data + first);
+            std::destroy(temp + first, temp + last);
+        };
+        detail::RunBoundedChunks(bounds, scatter);
+        return data + boundary;
+    }
+}
+
+template <typename T, typename A, typename G, typename Fn>
+void ParallelForEach(Vector<T, A, G>& vector, Fn fn) {
+    ParallelForEach(vector.AsSpan(), std::move(fn));
+}
+
+template <typename T, typename A, typename G, typename U, typename B, typename H, typename UnaryOp>
+void ParallelTransform(const Vector<T, A, G>& in, Vector<U, B, H>& out, UnaryOp op) {
+    ParallelTransform(in.AsSpan(), out.AsSpan(), std::move(op));
+}
+
+template <typename T, typename A, typename G, typename U, typename BinaryOp = std::plus<>>
+U ParallelReduce(const Vector<T, A, G>& vector, U init, BinaryOp op = BinaryOp()) {
+    return ParallelReduce(vector.AsSpan(), std::move(init), std::move(op));
+}
+
+template <typename T, typename A, typename G, typename Compare = std::less<>>
+void ParallelSort(Vector<T, A, G>& vector, Compare comp = Compare()) {
+    ParallelSort(vector.AsSpan(), std::move(comp));
+}
+
+//       
+template <typename T, typename A, typename G, typename Predicate>
+typename Vector<T, A, G>::iterator ParallelPartition(Vector<T, A, G>& vector, Predicate pred) {
+    T* const boundary = ParallelPartition(vector.AsSpan(), std::move(pred));
+    return vector.begin() + (boundary - vector.Data());
+}
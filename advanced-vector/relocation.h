@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "instrumentation.h"
+
+//   :        
+// ,           .
+//      .   
+// (,  )   :
+//     template <> struct IsTriviallyRelocatable<MyHandle> : std::true_type {};
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {
+};
+
+template <typename T>
+inline constexpr bool IsTriviallyRelocatableV = IsTriviallyRelocatable<T>::value;
+
+namespace detail {
+
+    //   ,        
+    template <typename T>
+    inline constexpr bool RelocateByMoveV = !std::is_copy_constructible_v<T> || std::is_nothrow_move_constructible_v<T>;
+
+    //       to n   from:  , 
+    //  .     ,    
+    template <typename T>
+    void UninitializedRelocateN(T* from, size_t n, T* to) {
+        instrumentation::OnRelocate<T>(n, !IsTriviallyRelocatableV<T> && !RelocateByMoveV<T>);
+        if constexpr (IsTriviallyRelocatableV<T>) {
+            if (n != 0) {
+                std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(T));
+            }
+        }
+        else if constexpr (RelocateByMoveV<T>) {
+            std::uninitialized_move_n(from, n, to);
+        }
+        else {
+            std::uninitialized_copy_n(from, n, to);
+        }
+    }
+
+    //  ,   .    
+    //   ,      
+    template <typename T>
+    void DestroyRelocatedN(T* from, size_t n) noexcept {
+        if constexpr (!IsTriviallyRelocatableV<T>) {
+            std::destroy_n(from, n);
+        }
+    }
+
+    //  n   from      to
+    template <typename T>
+    void RelocateN(T* from, size_t n, T* to) {
+        UninitializedRelocateN(from, n, to);
+        DestroyRelocatedN(from, n);
+    }
+
+}  // namespace detail
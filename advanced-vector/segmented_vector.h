@@ -0,0 +1,489 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+namespace detail {
+
+    //      :  ,    
+    //  4 ,    16 
+    template <typename T>
+    constexpr size_t DefaultSegmentSize() noexcept {
+        size_t size = 16;
+        while (size * 2 * sizeof(T) <= 4096) {
+            size *= 2;
+        }
+        return size;
+    }
+
+}  // namespace detail
+
+//     .       
+//  ,          
+// ,   EmplaceBack     .     
+//     .
+//         ShrinkToFit
+template <typename T, typename Allocator = std::allocator<T>, size_t SegmentSize = detail::DefaultSegmentSize<T>()>
+class SegmentedVector {
+    static_assert(SegmentSize != 0 && (SegmentSize & (SegmentSize - 1)) == 0, "SegmentSize must be a power of two");
+
+    using Segment = RawMemory<T, Allocator>;
+    using SegmentTable = Vector<Segment, typename std::allocator_traits<Allocator>::template rebind_alloc<Segment>>;
+
+    template <bool IsConst>
+    class Iterator {
+        using Table = std::conditional_t<IsConst, const SegmentTable, SegmentTable>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        Iterator() noexcept = default;
+        Iterator(Table* segments, size_t index) noexcept
+            : segments_(segments)
+            , index_(index)  //
+        {
+        }
+        //     
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) noexcept
+            : segments_(other.segments_)
+            , index_(other.index_)  //
+        {
+        }
+
+        reference operator*() const noexcept {
+            return (*segments_)[index_ / SegmentSize][index_ % SegmentSize];
+        }
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        Iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++index_;
+            return old;
+        }
+        Iterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --index_;
+            return old;
+        }
+        Iterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+        Iterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+        friend Iterator operator+(Iterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+        friend Iterator operator+(difference_type offset, Iterator it) noexcept {
+            return it += offset;
+        }
+        friend Iterator operator-(Iterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+        friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+        friend bool operator>(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+        friend bool operator<=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+        friend bool operator>=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+    private:
+        template <bool>
+        friend class Iterator;
+
+        Table* segments_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using allocator_type = Allocator;
+
+    static constexpr size_t SEGMENT_SIZE = SegmentSize;
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    SegmentedVector() = default;
+    explicit SegmentedVector(const Allocator& alloc) noexcept;
+    explicit SegmentedVector(size_t size, const Allocator& alloc = Allocator());
+
+    SegmentedVector(const SegmentedVector& other);
+    SegmentedVector& operator=(const SegmentedVector& rhs);
+
+    SegmentedVector(SegmentedVector&& other) noexcept;
+    SegmentedVector& operator=(SegmentedVector&& rhs) noexcept;
+
+    //     
+    void Swap(SegmentedVector& other) noexcept;
+
+    Allocator GetAllocator() const noexcept;
+
+    size_t Size() const noexcept;
+    size_t Capacity() const noexcept;
+    size_t SegmentCount() const noexcept;
+
+    //   ,     new_capacity 
+    void Reserve(size_t new_capacity);
+    //  ,    
+    void ShrinkToFit() noexcept;
+    void Clear() noexcept;
+    void Resize(size_t new_size);
+    void PushBack(const T& value);
+    void PushBack(T&& value);
+    void PopBack() /* noexcept */;
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+
+    //   
+    Vector<T, Allocator> Flatten() const&;
+    //     ;    
+    Vector<T, Allocator> Flatten() &&;
+
+    const T& operator[](size_t index) const noexcept;
+    T& operator[](size_t index) noexcept;
+
+    ~SegmentedVector();
+
+private:
+    //       index    
+    T* Slot(size_t index) noexcept;
+
+    //  ,    new_capacity.   , 
+    //    Reserve  Resize,      
+    void AddSegments(size_t new_capacity);
+
+    //     new_size
+    void DestroyFrom(size_t new_size) noexcept;
+
+private:
+    SegmentTable segments_;
+    Allocator alloc_;
+    size_t size_ = 0;
+};
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline typename SegmentedVector<T, Allocator, SegmentSize>::iterator SegmentedVector<T, Allocator, SegmentSize>::begin() noexcept
+{
+    return iterator(&segments_, 0);
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline typename SegmentedVector<T, Allocator, SegmentSize>::iterator SegmentedVector<T, Allocator, SegmentSize>::end() noexcept
+{
+    return iterator(&segments_, size_);
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline typename SegmentedVector<T, Allocator, SegmentSize>::const_iterator SegmentedVector<T, Allocator, SegmentSize>::begin() const noexcept
+{
+    return const_iterator(&segments_, 0);
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline typename SegmentedVector<T, Allocator, SegmentSize>::const_iterator SegmentedVector<T, Allocator, SegmentSize>::end() const noexcept
+{
+    return const_iterator(&segments_, size_);
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline typename SegmentedVector<T, Allocator, SegmentSize>::const_iterator SegmentedVector<T, Allocator, SegmentSize>::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline typename SegmentedVector<T, Allocator, SegmentSize>::const_iterator SegmentedVector<T, Allocator, SegmentSize>::cend() const noexcept
+{
+    return end();
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline SegmentedVector<T, Allocator, SegmentSize>::SegmentedVector(const Allocator& alloc) noexcept
+    : segments_(typename SegmentTable::allocator_type(alloc))
+    , alloc_(alloc)
+{
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline SegmentedVector<T, Allocator, SegmentSize>::SegmentedVector(size_t size, const Allocator& alloc)
+    : SegmentedVector(alloc)
+{
+    Resize(size);
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline SegmentedVector<T, Allocator, SegmentSize>::SegmentedVector(const SegmentedVector& other)
+    : SegmentedVector(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.alloc_))
+{
+    Reserve(other.size_);
+    for (const T& value : other)
+    {
+        EmplaceBack(value);
+    }
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline SegmentedVector<T, Allocator, SegmentSize>& SegmentedVector<T, Allocator, SegmentSize>::operator=(const SegmentedVector& rhs)
+{
+    if (this != &rhs)
+    {
+        SegmentedVector rhs_copy(rhs);
+        Swap(rhs_copy);
+    }
+    return *this;
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline SegmentedVector<T, Allocator, SegmentSize>::SegmentedVector(SegmentedVector&& other) noexcept
+    : segments_(std::move(other.segments_))
+    , alloc_(other.alloc_)
+    , size_(std::exchange(other.size_, 0))
+{
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline SegmentedVector<T, Allocator, SegmentSize>& SegmentedVector<T, Allocator, SegmentSize>::operator=(SegmentedVector&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        SegmentedVector rhs_moved(std::move(rhs));
+        Swap(rhs_moved);
+    }
+    return *this;
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline void SegmentedVector<T, Allocator, SegmentSize>::Swap(SegmentedVector& other) noexcept
+{
+    segments_.Swap(other.segments_);
+    std::swap(alloc_, other.alloc_);
+    std::swap(size_, other.size_);
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline Allocator SegmentedVector<T, Allocator, SegmentSize>::GetAllocator() const noexcept
+{
+    return alloc_;
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline size_t SegmentedVector<T, Allocator, SegmentSize>::Size() const noexcept
+{
+    return size_;
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline size_t SegmentedVector<T, Allocator, SegmentSize>::Capacity() const noexcept
+{
+    return segments_.Size() * SegmentSize;
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline size_t SegmentedVector<T, Allocator, SegmentSize>::SegmentCount() const noexcept
+{
+    return segments_.Size();
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline void SegmentedVector<T, Allocator, SegmentSize>::Reserve(size_t new_capacity)
+{
+    AddSegments(new_capacity);
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline void SegmentedVector<T, Allocator, SegmentSize>::ShrinkToFit() noexcept
+{
+    const size_t used = (size_ + SegmentSize - 1) / SegmentSize;
+    while (segments_.Size() > used)
+    {
+        segments_.PopBack();
+    }
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline void SegmentedVector<T, Allocator, SegmentSize>::Clear() noexcept
+{
+    DestroyFrom(0);
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline void SegmentedVector<T, Allocator, SegmentSize>::Resize(size_t new_size)
+{
+    if (new_size < size_)
+    {
+        DestroyFrom(new_size);
+        return;
+    }
+    AddSegments(new_size);
+    while (size_ < new_size)
+    {
+        EmplaceBack();
+    }
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline void SegmentedVector<T, Allocator, SegmentSize>::PushBack(const T& value)
+{
+    EmplaceBack(value);
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline void SegmentedVector<T, Allocator, SegmentSize>::PushBack(T&& value)
+{
+    EmplaceBack(std::move(value));
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline void SegmentedVector<T, Allocator, SegmentSize>::PopBack()
+{
+    assert(size_ > 0);
+    std::destroy_at(Slot(size_ - 1));
+    --size_;
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+template<typename... Args>
+inline T& SegmentedVector<T, Allocator, SegmentSize>::EmplaceBack(Args&&... args)
+{
+    //      Vector,    Reserve,   
+    //     .     ,  
+    //    
+    if (size_ == Capacity())
+    {
+        segments_.EmplaceBack(SegmentSize, alloc_);
+    }
+    T* slot = new (Slot(size_)) T(std::forward<Args>(args)...);
+    ++size_;
+    return *slot;
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline Vector<T, Allocator> SegmentedVector<T, Allocator, SegmentSize>::Flatten() const&
+{
+    Vector<T, Allocator> result(alloc_);
+    result.Reserve(size_);
+    for (size_t first = 0; first < size_; first += SegmentSize)
+    {
+        const T* segment = segments_[first / SegmentSize].GetAddress();
+        result.Append(segment, segment + std::min(SegmentSize, size_ - first));
+    }
+    return result;
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline Vector<T, Allocator> SegmentedVector<T, Allocator, SegmentSize>::Flatten() &&
+{
+    Vector<T, Allocator> result(alloc_);
+    result.Reserve(size_);
+    for (size_t first = 0; first < size_; first += SegmentSize)
+    {
+        T* segment = segments_[first / SegmentSize].GetAddress();
+        result.Append(std::make_move_iterator(segment), std::make_move_iterator(segment + std::min(SegmentSize, size_ - first)));
+    }
+    Clear();
+    ShrinkToFit();
+    return result;
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline const T& SegmentedVector<T, Allocator, SegmentSize>::operator[](size_t index) const noexcept
+{
+    return const_cast<SegmentedVector&>(*this)[index];
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline T& SegmentedVector<T, Allocator, SegmentSize>::operator[](size_t index) noexcept
+{
+    assert(index < size_);
+    return *Slot(index);
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline SegmentedVector<T, Allocator, SegmentSize>::~SegmentedVector()
+{
+    DestroyFrom(0);
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline T* SegmentedVector<T, Allocator, SegmentSize>::Slot(size_t index) noexcept
+{
+    return segments_[index / SegmentSize] + index % SegmentSize;
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline void SegmentedVector<T, Allocator, SegmentSize>::AddSegments(size_t new_capacity)
+{
+    if (Capacity() >= new_capacity)
+    {
+        return;
+    }
+    segments_.Reserve((new_capacity + SegmentSize - 1) / SegmentSize);
+    while (Capacity() < new_capacity)
+    {
+        //       ,     
+        segments_.EmplaceBack(SegmentSize, alloc_);
+    }
+}
+
+template<typename T, typename Allocator, size_t SegmentSize>
+inline void SegmentedVector<T, Allocator, SegmentSize>::DestroyFrom(size_t new_size) noexcept
+{
+    if constexpr (!std::is_trivially_destructible_v<T>)
+    {
+        for (size_t first = new_size; first < size_;)
+        {
+            const size_t last = std::min(size_, (first / SegmentSize + 1) * SegmentSize);
+            std::destroy_n(Slot(first), last - first);
+            first = last;
+        }
+    }
+    size_ = new_size;
+}
@@ -0,0 +1,397 @@
+#pragma once
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include "vector.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ADVANCED_VECTOR_HAS_POSIX_IO 1
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+//   :  SerializedVectorHeader    . 
+//           ,
+//     Serializer<T>.
+//       std::ostream/std::istream,   
+// POSIX (  writev)     AsyncVectorReader 
+//   io_uring,     
+
+struct SerializedVectorHeader {
+    static constexpr char MAGIC[8] = { 'A', 'V', 'S', 'E', 'R', '\0', '\0', '\0' };
+    static constexpr uint32_t VERSION = 1;
+    //     
+    static constexpr uint32_t RAW_ELEMENTS = 1;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t element_size;
+    uint64_t count;
+};
+static_assert(sizeof(SerializedVectorHeader) == 32, "Header layout must not change");
+
+//       T.     ,
+//    ;     :
+//     template <> struct Serializer<Person> {
+//         static void Write(std::ostream& out, const Person& value);
+//         static Person Read(std::istream& in);
+//     };
+template <typename T, typename = void>
+struct Serializer;
+
+namespace detail {
+
+    inline void WriteBytes(std::ostream& out, const void* data, size_t bytes) {
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        if (!out) {
+            throw std::ios_base::failure("Failed to write serialized vector");
+        }
+    }
+
+    inline void ReadBytes(std::istream& in, void* data, size_t bytes) {
+        in.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes));
+        if (static_cast<size_t>(in.gcount()) != bytes) {
+            throw std::ios_base::failure("Serialized vector is truncated");
+        }
+    }
+
+    template <typename T>
+    inline constexpr bool RawSerializableV = std::is_trivially_copyable_v<T>;
+
+    //           
+    template <typename T>
+    inline constexpr bool FillableInPlaceV = std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>;
+
+    template <typename T>
+    SerializedVectorHeader MakeHeader(size_t count) noexcept {
+        SerializedVectorHeader header{};
+        std::memcpy(header.magic, SerializedVectorHeader::MAGIC, sizeof(header.magic));
+        header.version = SerializedVectorHeader::VERSION;
+        header.flags = RawSerializableV<T> ? SerializedVectorHeader::RAW_ELEMENTS : 0;
+        header.element_size = RawSerializableV<T> ? sizeof(T) : 0;
+        header.count = count;
+        return header;
+    }
+
+    // ,      T,    
+    template <typename T>
+    size_t ValidateHeader(const SerializedVectorHeader& header) {
+        const SerializedVectorHeader expected = MakeHeader<T>(0);
+        if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != expected.version) {
+            throw std::runtime_error("Not a serialized vector");
+        }
+        if (header.flags != expected.flags || header.element_size != expected.element_size) {
+            throw std::runtime_error("Serialized vector holds elements of another type");
+        }
+        if (header.count > detail::MaxCapacity(sizeof(T))) {
+            throw std::length_error("Serialized vector is too large");
+        }
+        return static_cast<size_t>(header.count);
+    }
+
+}  // namespace detail
+
+template <typename T>
+struct Serializer<T, std::enable_if_t<std::is_trivially_copyable_v<T>>> {
+    static void Write(std::ostream& out, const T& value) {
+        detail::WriteBytes(out, &value, sizeof(T));
+    }
+
+    static T Read(std::istream& in) {
+        T value;
+        detail::ReadBytes(in, &value, sizeof(T));
+        return value;
+    }
+};
+
+template <typename Char, typename Traits, typename Alloc>
+struct Serializer<std::basic_string<Char, Traits, Alloc>> {
+    static void Write(std::ostream& out, const std::basic_string<Char, Traits, Alloc>& value) {
+        Serializer<uint64_t>::Write(out, value.size());
+        detail::WriteBytes(out, value.data(), value.size() * sizeof(Char));
+    }
+
+    static std::basic_string<Char, Traits, Alloc> Read(std::istream& in) {
+        const uint64_t size = Serializer<uint64_t>::Read(in);
+        std::basic_string<Char, Traits, Alloc> value;
+        //   ,        
+        constexpr size_t CHUNK = 4096;
+        for (uint64_t done = 0; done < size;) {
+            const size_t part = static_cast<size_t>(std::min<uint64_t>(CHUNK, size - done));
+            value.resize(static_cast<size_t>(done) + part);
+            detail::ReadBytes(in, value.data() + done, part * sizeof(Char));
+            done += part;
+        }
+        return value;
+    }
+};
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+void WriteVector(std::ostream& out, const Vector<T, Allocator, GrowthPolicy>& vector);
+template <typename T, typename Allocator, typename GrowthPolicy>
+void ReadVector(std::istream& in, Vector<T, Allocator, GrowthPolicy>& vector, size_t chunk_elements = 1 << 16);
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+struct Serializer<Vector<T, Allocator, GrowthPolicy>> {
+    static void Write(std::ostream& out, const Vector<T, Allocator, GrowthPolicy>& value) {
+        WriteVector(out, value);
+    }
+
+    static Vector<T, Allocator, GrowthPolicy> Read(std::istream& in) {
+        Vector<T, Allocator, GrowthPolicy> value;
+        ReadVector(in, value);
+        return value;
+    }
+};
+
+//    .      
+template <typename T, typename Allocator, typename GrowthPolicy>
+void WriteVector(std::ostream& out, const Vector<T, Allocator, GrowthPolicy>& vector)
+{
+    const SerializedVectorHeader header = detail::MakeHeader<T>(vector.Size());
+    detail::WriteBytes(out, &header, sizeof(header));
+    if constexpr (detail::RawSerializableV<T>)
+    {
+        if (vector.Size() != 0)
+        {
+            detail::WriteBytes(out, vector.Data(), vector.Size() * sizeof(T));
+        }
+    }
+    else
+    {
+        for (const T& value : vector)
+        {
+            Serializer<T>::Write(out, value);
+        }
+    }
+}
+
+//      .      
+//  ,       chunk_elements    
+//   
+template <typename T, typename Allocator, typename GrowthPolicy>
+void ReadVector(std::istream& in, Vector<T, Allocator, GrowthPolicy>& vector, size_t chunk_elements)
+{
+    assert(chunk_elements != 0);
+    SerializedVectorHeader header;
+    detail::ReadBytes(in, &header, sizeof(header));
+    const size_t count = detail::ValidateHeader<T>(header);
+    vector.Clear();
+    vector.Reserve(count);
+    while (vector.Size() < count)
+    {
+        const size_t part = std::min(chunk_elements, count - vector.Size());
+        if constexpr (detail::FillableInPlaceV<T>)
+        {
+            vector.ResizeAndOverwrite(vector.Size() + part, [&in](T* tail, size_t n) {
+                in.read(reinterpret_cast<char*>(tail), static_cast<std::streamsize>(n * sizeof(T)));
+                return static_cast<size_t>(in.gcount()) / sizeof(T);
+            });
+            if (!in)
+            {
+                throw std::ios_base::failure("Serialized vector is truncated");
+            }
+        }
+        else if constexpr (detail::RawSerializableV<T>)
+        {
+            const size_t first = vector.Size();
+            vector.ResizeDefaultInit(first + part);
+            detail::ReadBytes(in, vector.Data() + first, part * sizeof(T));
+        }
+        else
+        {
+            for (size_t i = 0; i < part; ++i)
+            {
+                vector.EmplaceBack(Serializer<T>::Read(in));
+            }
+        }
+    }
+}
+
+#if defined(ADVANCED_VECTOR_HAS_POSIX_IO)
+namespace detail {
+
+    //   ,  writev   
+    inline void WriteAll(int fd, iovec* buffers, int count) {
+        while (count != 0) {
+            const ssize_t written = writev(fd, buffers, count);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "writev");
+            }
+            size_t rest = static_cast<size_t>(written);
+            while (count != 0 && rest >= buffers->iov_len) {
+                rest -= buffers->iov_len;
+                ++buffers;
+                --count;
+            }
+            if (count != 0) {
+                buffers->iov_base = static_cast<char*>(buffers->iov_base) + rest;
+                buffers->iov_len -= rest;
+            }
+        }
+    }
+
+    //   bytes ,  read   .    
+    inline size_t ReadSome(int fd, void* data, size_t bytes) {
+        size_t done = 0;
+        while (done < bytes) {
+            const ssize_t result = read(fd, static_cast<char*>(data) + done, bytes - done);
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "read");
+            }
+            if (result == 0) {
+                break;
+            }
+            done += static_cast<size_t>(result);
+        }
+        return done;
+    }
+
+}  // namespace detail
+
+//     .     
+//    writev,      
+template <typename T, typename Allocator, typename GrowthPolicy>
+void WriteVector(int fd, const Vector<T, Allocator, GrowthPolicy>& vector)
+{
+    if constexpr (detail::RawSerializableV<T>)
+    {
+        SerializedVectorHeader header = detail::MakeHeader<T>(vector.Size());
+        iovec buffers[2] = {
+            { &header, sizeof(header) },
+            { const_cast<T*>(vector.Data()), vector.Size() * sizeof(T) },
+        };
+        detail::WriteAll(fd, buffers, vector.Size() != 0 ? 2 : 1);
+    }
+    else
+    {
+        std::ostringstream out;
+        WriteVector(out, vector);
+        std::string bytes = out.str();
+        iovec buffer = { bytes.data(), bytes.size() };
+        detail::WriteAll(fd, &buffer, 1);
+    }
+}
+
+//       
+template <typename T, typename Allocator, typename GrowthPolicy>
+void ReadVector(int fd, Vector<T, Allocator, GrowthPolicy>& vector, size_t chunk_elements = 1 << 16)
+{
+    static_assert(detail::RawSerializableV<T>, "Only trivially copyable elements can be read from a descriptor");
+    assert(chunk_elements != 0);
+    SerializedVectorHeader header;
+    if (detail::ReadSome(fd, &header, sizeof(header)) != sizeof(header))
+    {
+        throw std::runtime_error("Serialized vector is truncated");
+    }
+    const size_t count = detail::ValidateHeader<T>(header);
+    vector.Clear();
+    vector.Reserve(count);
+    while (vector.Size() < count)
+    {
+        const size_t part = std::min(chunk_elements, count - vector.Size());
+        size_t read_bytes = 0;
+        if constexpr (detail::FillableInPlaceV<T>)
+        {
+            vector.ResizeAndOverwrite(vector.Size() + part, [fd, &read_bytes](T* tail, size_t n) {
+                read_bytes = detail::ReadSome(fd, tail, n * sizeof(T));
+                return read_bytes / sizeof(T);
+            });
+        }
+        else
+        {
+            const size_t first = vector.Size();
+            vector.ResizeDefaultInit(first + part);
+            read_bytes = detail::ReadSome(fd, vector.Data() + first, part * sizeof(T));
+        }
+        if (read_bytes != part * sizeof(T))
+        {
+            throw std::runtime_error("Serialized vector is truncated");
+        }
+    }
+}
+#endif
+
+//  -:     
+struct IoBuffer {
+    void* data;
+    size_t bytes;
+};
+
+//    .      count ;
+// Submit          ,
+//  Complete    .       .
+//      
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+class AsyncVectorReader {
+    static_assert(detail::FillableInPlaceV<T>, "Raw memory can be filled in place only for trivial types");
+
+public:
+    AsyncVectorReader(Vector<T, Allocator, GrowthPolicy>& target, size_t count)
+        : target_(target)
+        , count_(count)  //
+    {
+        target_.Clear();
+        target_.Reserve(count);
+    }
+
+    //   ,    SerializedVectorHeader
+    AsyncVectorReader(Vector<T, Allocator, GrowthPolicy>& target, const SerializedVectorHeader& header)
+        : AsyncVectorReader(target, detail::ValidateHeader<T>(header))  //
+    {
+    }
+
+    //    max_bytes    
+    IoBuffer Submit(size_t max_bytes = static_cast<size_t>(-1)) noexcept {
+        assert(!submitted_);
+        submitted_ = true;
+        unsigned char* tail = reinterpret_cast<unsigned char*>(target_.Data() + target_.Size()) + pending_bytes_;
+        return { tail, std::min(max_bytes, RemainingBytes()) };
+    }
+
+    //  bytes ,     Submit
+    void Complete(size_t bytes) {
+        assert(submitted_ && bytes <= RemainingBytes());
+        submitted_ = false;
+        pending_bytes_ += bytes;
+        const size_t whole = pending_bytes_ / sizeof(T);
+        if (whole != 0) {
+            target_.ResizeAndOverwrite(target_.Size() + whole, [whole](T* /*tail*/, size_t /*n*/) {
+                return whole;
+            });
+            pending_bytes_ -= whole * sizeof(T);
+        }
+    }
+
+    size_t RemainingBytes() const noexcept {
+        return (count_ - target_.Size()) * sizeof(T) - pending_bytes_;
+    }
+
+    bool Done() const noexcept {
+        return target_.Size() == count_;
+    }
+
+private:
+    Vector<T, Allocator, GrowthPolicy>& target_;
+    size_t count_;
+    //   ,     
+    size_t pending_bytes_ = 0;
+    bool submitted_ = false;
+};
@@ -0,0 +1,491 @@
+#pragma once
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ADVANCED_VECTOR_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define ADVANCED_VECTOR_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+//    ,    . MSVC 
+//     
+#if defined(__GNUC__) || defined(__clang__)
+#define ADVANCED_VECTOR_TARGET(isa) __attribute__((target(isa)))
+#else
+#define ADVANCED_VECTOR_TARGET(isa)
+#endif
+
+//   :  T     ,    
+// ( ,     ).    
+//      .      :
+// 0.0 == -0.0,  NaN    .      :
+//     template <> struct IsBitwiseComparable<Color> : std::true_type {};
+template <typename T>
+struct IsBitwiseComparable : std::bool_constant<std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>> {
+};
+
+template <typename T>
+inline constexpr bool IsBitwiseComparableV = IsBitwiseComparable<T>::value;
+
+//   ,     
+enum class SimdLevel {
+    SCALAR,
+    SSE2,
+    AVX2,
+    AVX512,
+    NEON,
+};
+
+namespace detail {
+
+    inline SimdLevel DetectSimdLevel() noexcept {
+#if defined(ADVANCED_VECTOR_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+            return SimdLevel::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return SimdLevel::AVX2;
+        }
+        return SimdLevel::SSE2;
+#elif defined(ADVANCED_VECTOR_SIMD_X86)
+        int info[4];
+        __cpuid(info, 1);
+        const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+        const bool os_saves_zmm = os_saves_ymm && (_xgetbv(0) & 0xE6) == 0xE6;
+        __cpuidex(info, 7, 0);
+        if (os_saves_zmm && (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 30)) != 0) {
+            return SimdLevel::AVX512;
+        }
+        if (os_saves_ymm && (info[1] & (1 << 5)) != 0) {
+            return SimdLevel::AVX2;
+        }
+        return SimdLevel::SSE2;
+#elif defined(ADVANCED_VECTOR_SIMD_NEON)
+        return SimdLevel::NEON;
+#else
+        return SimdLevel::SCALAR;
+#endif
+    }
+
+    inline size_t CountTrailingZeros(uint64_t mask) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctzll(mask));
+#else
+        size_t count = 0;
+        for (; (mask & 1) == 0; mask >>= 1) {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    inline size_t PopCount(uint64_t mask) noexcept {
+        return std::bitset<64>(mask).count();
+    }
+
+    //          W :
+    //  k * W  ,       k
+    template <size_t W>
+    uint64_t GroupMask(uint64_t mask) noexcept {
+        if constexpr (W >= 2) {
+            mask &= mask >> 1;
+        }
+        if constexpr (W >= 4) {
+            mask &= mask >> 2;
+        }
+        if constexpr (W >= 8) {
+            mask &= mask >> 4;
+        }
+        if constexpr (W == 1) {
+            return mask;
+        }
+        else if constexpr (W == 2) {
+            return mask & 0x5555555555555555ull;
+        }
+        else if constexpr (W == 4) {
+            return mask & 0x1111111111111111ull;
+        }
+        else {
+            return mask & 0x0101010101010101ull;
+        }
+    }
+
+    //  .   n   W ; pattern   
+    template <size_t W>
+    size_t FindEqualScalar(const unsigned char* data, size_t n, const unsigned char* pattern) noexcept {
+        for (size_t i = 0; i < n; ++i) {
+            if (std::memcmp(data + i * W, pattern, W) == 0) {
+                return i;
+            }
+        }
+        return n;
+    }
+
+    template <size_t W>
+    size_t CountEqualScalar(const unsigned char* data, size_t n, const unsigned char* pattern) noexcept {
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i) {
+            count += std::memcmp(data + i * W, pattern, W) == 0;
+        }
+        return count;
+    }
+
+    //       bytes,   
+    inline size_t MismatchScalar(const unsigned char* lhs, const unsigned char* rhs, size_t bytes) noexcept {
+        size_t i = 0;
+        while (i < bytes && lhs[i] == rhs[i]) {
+            ++i;
+        }
+        return i;
+    }
+
+#if defined(ADVANCED_VECTOR_SIMD_X86)
+    //    x86:        ,
+    //      ,    .
+    // pattern     64 
+
+    template <size_t W>
+    ADVANCED_VECTOR_TARGET("sse2") size_t FindEqualSse2(const unsigned char* data, size_t n, const unsigned char* pattern) noexcept {
+        const size_t bytes = n * W;
+        const __m128i needle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+        size_t i = 0;
+        for (; i + 16 <= bytes; i += 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            const uint64_t mask = GroupMask<W>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle))));
+            if (mask != 0) {
+                return (i + CountTrailingZeros(mask)) / W;
+            }
+        }
+        return i / W + FindEqualScalar<W>(data + i, n - i / W, pattern);
+    }
+
+    template <size_t W>
+    ADVANCED_VECTOR_TARGET("sse2") size_t CountEqualSse2(const unsigned char* data, size_t n, const unsigned char* pattern) noexcept {
+        const size_t bytes = n * W;
+        const __m128i needle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 16 <= bytes; i += 16) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            count += PopCount(GroupMask<W>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle)))));
+        }
+        return count + CountEqualScalar<W>(data + i, n - i / W, pattern);
+    }
+
+    ADVANCED_VECTOR_TARGET("sse2") inline size_t MismatchSse2(const unsigned char* lhs, const unsigned char* rhs, size_t bytes) noexcept {
+        size_t i = 0;
+        for (; i + 16 <= bytes; i += 16) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+            const uint32_t mask = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) & 0xFFFFu;
+            if (mask != 0) {
+                return i + CountTrailingZeros(mask);
+            }
+        }
+        return i + MismatchScalar(lhs + i, rhs + i, bytes - i);
+    }
+
+    template <size_t W>
+    ADVANCED_VECTOR_TARGET("avx2") size_t FindEqualAvx2(const unsigned char* data, size_t n, const unsigned char* pattern) noexcept {
+        const size_t bytes = n * W;
+        const __m256i needle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+        size_t i = 0;
+        for (; i + 32 <= bytes; i += 32) {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            const uint64_t mask = GroupMask<W>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle))));
+            if (mask != 0) {
+                return (i + CountTrailingZeros(mask)) / W;
+            }
+        }
+        return i / W + FindEqualSse2<W>(data + i, n - i / W, pattern);
+    }
+
+    template <size_t W>
+    ADVANCED_VECTOR_TARGET("avx2") size_t CountEqualAvx2(const unsigned char* data, size_t n, const unsigned char* pattern) noexcept {
+        const size_t bytes = n * W;
+        const __m256i needle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 32 <= bytes; i += 32) {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            count += PopCount(GroupMask<W>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle)))));
+        }
+        return count + CountEqualSse2<W>(data + i, n - i / W, pattern);
+    }
+
+    ADVANCED_VECTOR_TARGET("avx2") inline size_t MismatchAvx2(const unsigned char* lhs, const unsigned char* rhs, size_t bytes) noexcept {
+        size_t i = 0;
+        for (; i + 32 <= bytes; i += 32) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i));
+            const uint32_t mask = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+            if (mask != 0) {
+                return i + CountTrailingZeros(mask);
+            }
+        }
+        return i + MismatchSse2(lhs + i, rhs + i, bytes - i);
+    }
+
+    template <size_t W>
+    ADVANCED_VECTOR_TARGET("avx512f,avx512bw") size_t FindEqualAvx512(const unsigned char* data, size_t n, const unsigned char* pattern) noexcept {
+        const size_t bytes = n * W;
+        const __m512i needle = _mm512_loadu_si512(pattern);
+        size_t i = 0;
+        for (; i + 64 <= bytes; i += 64) {
+            const __m512i block = _mm512_loadu_si512(data + i);
+            const uint64_t mask = GroupMask<W>(_mm512_cmpeq_epi8_mask(block, needle));
+            if (mask != 0) {
+                return (i + CountTrailingZeros(mask)) / W;
+            }
+        }
+        return i / W + FindEqualAvx2<W>(data + i, n - i / W, pattern);
+    }
+
+    template <size_t W>
+    ADVANCED_VECTOR_TARGET("avx512f,avx512bw") size_t CountEqualAvx512(const unsigned char* data, size_t n, const unsigned char* pattern) noexcept {
+        const size_t bytes = n * W;
+        const __m512i needle = _mm512_loadu_si512(pattern);
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 64 <= bytes; i += 64) {
+            const __m512i block = _mm512_loadu_si512(data + i);
+            count += PopCount(GroupMask<W>(_mm512_cmpeq_epi8_mask(block, needle)));
+        }
+        return count + CountEqualAvx2<W>(data + i, n - i / W, pattern);
+    }
+
+    ADVANCED_VECTOR_TARGET("avx512f,avx512bw") inline size_t MismatchAvx512(const unsigned char* lhs, const unsigned char* rhs, size_t bytes) noexcept {
+        size_t i = 0;
+        for (; i + 64 <= bytes; i += 64) {
+            const uint64_t mask = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(lhs + i), _mm512_loadu_si512(rhs + i));
+            if (mask != 0) {
+                return i + CountTrailingZeros(mask);
+            }
+        }
+        return i + MismatchAvx2(lhs + i, rhs + i, bytes - i);
+    }
+#endif
+
+#if defined(ADVANCED_VECTOR_SIMD_NEON)
+    //    AArch64.  NEON   movemask,    
+    //   ,      
+
+    //   :     0xFF,   
+    template <size_t W>
+    uint8x16_t CompareLanesNeon(uint8x16_t a, uint8x16_t b) noexcept {
+        if constexpr (W == 1) {
+            return vceqq_u8(a, b);
+        }
+        else if constexpr (W == 2) {
+            return vreinterpretq_u8_u16(vceqq_u16(vreinterpretq_u16_u8(a), vreinterpretq_u16_u8(b)));
+        }
+        else if constexpr (W == 4) {
+            return vreinterpretq_u8_u32(vceqq_u32(vreinterpretq_u32_u8(a), vreinterpretq_u32_u8(b)));
+        }
+        else {
+            return vreinterpretq_u8_u64(vceqq_u64(vreinterpretq_u64_u8(a), vreinterpretq_u64_u8(b)));
+        }
+    }
+
+    template <size_t W>
+    size_t CountLanesNeon(uint8x16_t equal) noexcept {
+        if constexpr (W == 1) {
+            return vaddvq_u8(vshrq_n_u8(equal, 7));
+        }
+        else if constexpr (W == 2) {
+            return vaddvq_u16(vshrq_n_u16(vreinterpretq_u16_u8(equal), 15));
+        }
+        else if constexpr (W == 4) {
+            return vaddvq_u32(vshrq_n_u32(vreinterpretq_u32_u8(equal), 31));
+        }
+        else {
+            return static_cast<size_t>(vaddvq_u64(vshrq_n_u64(vreinterpretq_u64_u8(equal), 63)));
+        }
+    }
+
+    template <size_t W>
+    size_t FindEqualNeon(const unsigned char* data, size_t n, const unsigned char* pattern) noexcept {
+        const size_t bytes = n * W;
+        const uint8x16_t needle = vld1q_u8(pattern);
+        size_t i = 0;
+        for (; i + 16 <= bytes; i += 16) {
+            if (vmaxvq_u8(CompareLanesNeon<W>(vld1q_u8(data + i), needle)) != 0) {
+                return i / W + FindEqualScalar<W>(data + i, 16 / W, pattern);
+            }
+        }
+        return i / W + FindEqualScalar<W>(data + i, n - i / W, pattern);
+    }
+
+    template <size_t W>
+    size_t CountEqualNeon(const unsigned char* data, size_t n, const unsigned char* pattern) noexcept {
+        const size_t bytes = n * W;
+        const uint8x16_t needle = vld1q_u8(pattern);
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 16 <= bytes; i += 16) {
+            count += CountLanesNeon<W>(CompareLanesNeon<W>(vld1q_u8(data + i), needle));
+        }
+        return count + CountEqualScalar<W>(data + i, n - i / W, pattern);
+    }
+
+    inline size_t MismatchNeon(const unsigned char* lhs, const unsigned char* rhs, size_t bytes) noexcept {
+        size_t i = 0;
+        for (; i + 16 <= bytes; i += 16) {
+            if (vminvq_u8(vceqq_u8(vld1q_u8(lhs + i), vld1q_u8(rhs + i))) != 0xFF) {
+                break;
+            }
+        }
+        return i + MismatchScalar(lhs + i, rhs + i, bytes - i);
+    }
+#endif
+
+    //      level,    
+    template <size_t W>
+    size_t FindEqualBytes(SimdLevel level, const unsigned char* data, size_t n, const unsigned char* pattern) noexcept {
+        switch (level) {
+#if defined(ADVANCED_VECTOR_SIMD_X86)
+        case SimdLevel::AVX512:
+            return FindEqualAvx512<W>(data, n, pattern);
+        case SimdLevel::AVX2:
+            return FindEqualAvx2<W>(data, n, pattern);
+        case SimdLevel::SSE2:
+            return FindEqualSse2<W>(data, n, pattern);
+#endif
+#if defined(ADVANCED_VECTOR_SIMD_NEON)
+        case SimdLevel::NEON:
+            return FindEqualNeon<W>(data, n, pattern);
+#endif
+        default:
+            return FindEqualScalar<W>(data, n, pattern);
+        }
+    }
+
+    template <size_t W>
+    size_t CountEqualBytes(SimdLevel level, const unsigned char* data, size_t n, const unsigned char* pattern) noexcept {
+        switch (level) {
+#if defined(ADVANCED_VECTOR_SIMD_X86)
+        case SimdLevel::AVX512:
+            return CountEqualAvx512<W>(data, n, pattern);
+        case SimdLevel::AVX2:
+            return CountEqualAvx2<W>(data, n, pattern);
+        case SimdLevel::SSE2:
+            return CountEqualSse2<W>(data, n, pattern);
+#endif
+#if defined(ADVANCED_VECTOR_SIMD_NEON)
+        case SimdLevel::NEON:
+            return CountEqualNeon<W>(data, n, pattern);
+#endif
+        default:
+            return CountEqualScalar<W>(data, n, pattern);
+        }
+    }
+
+    inline size_t MismatchBytes(SimdLevel level, const unsigned char* lhs, const unsigned char* rhs, size_t bytes) noexcept {
+        switch (level) {
+#if defined(ADVANCED_VECTOR_SIMD_X86)
+        case SimdLevel::AVX512:
+            return MismatchAvx512(lhs, rhs, bytes);
+        case SimdLevel::AVX2:
+            return MismatchAvx2(lhs, rhs, bytes);
+        case SimdLevel::SSE2:
+            return MismatchSse2(lhs, rhs, bytes);
+#endif
+#if defined(ADVANCED_VECTOR_SIMD_NEON)
+        case SimdLevel::NEON:
+            return MismatchNeon(lhs, rhs, bytes);
+#endif
+        default:
+            return MismatchScalar(lhs, rhs, bytes);
+        }
+    }
+
+    //          1, 2, 4  8
+    template <typename T>
+    inline constexpr bool SimdSearchableV = IsBitwiseComparableV<T> && std::is_trivially_copyable_v<T>
+        && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+    //  64     value
+    template <typename T>
+    void FillPattern(unsigned char (&pattern)[64], const T& value) noexcept {
+        for (size_t i = 0; i < sizeof(pattern); i += sizeof(T)) {
+            std::memcpy(pattern + i, &value, sizeof(T));
+        }
+    }
+
+}  // namespace detail
+
+//    ,  .   
+inline SimdLevel ActiveSimdLevel() noexcept {
+    static const SimdLevel level = detail::DetectSimdLevel();
+    return level;
+}
+
+namespace detail {
+
+    //   ,  value,  n
+    template <typename T>
+    size_t FindValue(SimdLevel level, const T* data, size_t n, const T& value) {
+        if constexpr (SimdSearchableV<T>) {
+            unsigned char pattern[64];
+            FillPattern(pattern, value);
+            return FindEqualBytes<sizeof(T)>(level, reinterpret_cast<const unsigned char*>(data), n, pattern);
+        }
+        else {
+            return static_cast<size_t>(std::find(data, data + n, value) - data);
+        }
+    }
+
+    template <typename T>
+    size_t CountValue(SimdLevel level, const T* data, size_t n, const T& value) {
+        if constexpr (SimdSearchableV<T>) {
+            unsigned char pattern[64];
+            FillPattern(pattern, value);
+            return CountEqualBytes<sizeof(T)>(level, reinterpret_cast<const unsigned char*>(data), n, pattern);
+        }
+        else {
+            return static_cast<size_t>(std::count(data, data + n, value));
+        }
+    }
+
+    //   ,     lhs  rhs  n,  n
+    template <typename T>
+    size_t MismatchIndex(SimdLevel level, const T* lhs, const T* rhs, size_t n) {
+        if constexpr (IsBitwiseComparableV<T> && std::is_trivially_copyable_v<T>) {
+            return MismatchBytes(level, reinterpret_cast<const unsigned char*>(lhs), reinterpret_cast<const unsigned char*>(rhs),
+                n * sizeof(T)) / sizeof(T);
+        }
+        else {
+            return static_cast<size_t>(std::mismatch(lhs, lhs + n, rhs).first - lhs);
+        }
+    }
+
+    //     n  value.      (, ),
+    //   memset
+    template <typename T>
+    void UninitializedFillN(T* dest, size_t n, const T& value) {
+        if constexpr (std::is_trivially_copyable_v<T> && IsBitwiseComparableV<T>) {
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            if (std::all_of(bytes, bytes + sizeof(T), [&bytes](unsigned char b) { return b == bytes[0]; })) {
+                if (n != 0) {
+                    std::memset(static_cast<void*>(dest), bytes[0], n * sizeof(T));
+                }
+                return;
+            }
+        }
+        std::uninitialized_fill_n(dest, n, value);
+    }
+
+}  // namespace detail
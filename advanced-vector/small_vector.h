@@ -0,0 +1,488 @@
+#pragma once
+#include "vector.h"
+
+//      N .      ,
+//     ;      RawMemory.
+//        Vector.
+//    Vector,         
+template <typename T, size_t N, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+class SmallVector {
+    static_assert(N > 0, "Use Vector for vectors without inline storage");
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+    using allocator_type = Allocator;
+
+    static constexpr size_t INLINE_CAPACITY = N;
+
+    iterator begin() noexcept;
+    iterator end() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    SmallVector() = default;
+    explicit SmallVector(const Allocator& alloc) noexcept;
+    explicit SmallVector(size_t size, const Allocator& alloc = Allocator());
+
+    SmallVector(const SmallVector& other);
+    SmallVector& operator=(const SmallVector& rhs);
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T> || IsTriviallyRelocatableV<T>);
+    SmallVector& operator=(SmallVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T> || IsTriviallyRelocatableV<T>);
+
+    //     
+    void Swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T> || IsTriviallyRelocatableV<T>);
+
+    size_t Size() const noexcept;
+    size_t Capacity() const noexcept;
+    //     
+    bool IsInline() const noexcept;
+
+    Allocator GetAllocator() const noexcept;
+
+    void Reserve(size_t new_capacity);
+    void Resize(size_t new_size);
+    void PushBack(const T& value);
+    void PushBack(T&& value);
+    void PopBack() /* noexcept */;
+    iterator Insert(const_iterator pos, const T& value);
+    iterator Insert(const_iterator pos, T&& value);
+    iterator Erase(const_iterator pos);
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args);
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args);
+
+    const T& operator[](size_t index) const noexcept;
+    T& operator[](size_t index) noexcept;
+
+    ~SmallVector();
+
+private:
+    //   :      
+    T* Data() noexcept;
+    const T* Data() const noexcept;
+    T* InlineData() noexcept;
+
+    //        new_capacity
+    void Reallocate(size_t new_capacity);
+
+    //     other     ,  
+    //    .    
+    void RelocateInlineFrom(SmallVector& other);
+
+    size_t NextCapacity(size_t required) const noexcept;
+
+private:
+    alignas(T) unsigned char inline_[N * sizeof(T)];
+    RawMemory<T, Allocator> heap_;
+    size_t size_ = 0;
+};
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::iterator SmallVector<T, N, Allocator, GrowthPolicy>::begin() noexcept
+{
+    return Data();
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::iterator SmallVector<T, N, Allocator, GrowthPolicy>::end() noexcept
+{
+    return Data() + size_;
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::const_iterator SmallVector<T, N, Allocator, GrowthPolicy>::begin() const noexcept
+{
+    return Data();
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::const_iterator SmallVector<T, N, Allocator, GrowthPolicy>::end() const noexcept
+{
+    return Data() + size_;
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::const_iterator SmallVector<T, N, Allocator, GrowthPolicy>::cbegin() const noexcept
+{
+    return Data();
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::const_iterator SmallVector<T, N, Allocator, GrowthPolicy>::cend() const noexcept
+{
+    return Data() + size_;
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline SmallVector<T, N, Allocator, GrowthPolicy>::SmallVector(const Allocator& alloc) noexcept
+    : heap_(alloc)
+{
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline SmallVector<T, N, Allocator, GrowthPolicy>::SmallVector(size_t size, const Allocator& alloc)
+    : heap_(size > N ? size : 0, alloc)
+{
+    std::uninitialized_value_construct_n(Data(), size);
+    size_ = size;
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline SmallVector<T, N, Allocator, GrowthPolicy>::SmallVector(const SmallVector& other)
+    : heap_(other.size_ > N ? other.size_ : 0,
+        std::allocator_traits<Allocator>::select_on_container_copy_construction(other.heap_.GetAllocator()))
+{
+    std::uninitialized_copy_n(other.Data(), other.size_, Data());
+    size_ = other.size_;
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline SmallVector<T, N, Allocator, GrowthPolicy>& SmallVector<T, N, Allocator, GrowthPolicy>::operator=(const SmallVector& rhs)
+{
+    if (this != &rhs)
+    {
+        if (Capacity() >= rhs.size_)
+        {
+            const size_t common = std::min(size_, rhs.size_);
+            std::copy_n(rhs.Data(), common, Data());
+            if (rhs.size_ < size_)
+            {
+                std::destroy_n(Data() + rhs.size_, size_ - rhs.size_);
+            }
+            else
+            {
+                std::uninitialized_copy_n(rhs.Data() + size_, rhs.size_ - size_, Data() + size_);
+            }
+            size_ = rhs.size_;
+        }
+        else
+        {
+            //   ,   rhs   
+            RawMemory<T, Allocator> new_data(rhs.size_, heap_.GetAllocator());
+            std::uninitialized_copy_n(rhs.Data(), rhs.size_, new_data.GetAddress());
+            std::destroy_n(Data(), size_);
+            heap_.Swap(new_data);
+            size_ = rhs.size_;
+        }
+    }
+    return *this;
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline SmallVector<T, N, Allocator, GrowthPolicy>::SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T> || IsTriviallyRelocatableV<T>)
+    : heap_(other.heap_.GetAllocator())
+{
+    if (other.IsInline())
+    {
+        RelocateInlineFrom(other);
+    }
+    else
+    {
+        heap_.Swap(other.heap_);
+    }
+    size_ = std::exchange(other.size_, 0);
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline SmallVector<T, N, Allocator, GrowthPolicy>& SmallVector<T, N, Allocator, GrowthPolicy>::operator=(SmallVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T> || IsTriviallyRelocatableV<T>)
+{
+    if (this != &rhs)
+    {
+        std::destroy_n(Data(), size_);
+        size_ = 0;
+        if (rhs.IsInline())
+        {
+            if (!IsInline())
+            {
+                RawMemory<T, Allocator> empty(heap_.GetAllocator());
+                heap_.Swap(empty);
+            }
+            RelocateInlineFrom(rhs);
+        }
+        else
+        {
+            heap_.Swap(rhs.heap_);
+        }
+        size_ = std::exchange(rhs.size_, 0);
+    }
+    return *this;
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::Swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T> || IsTriviallyRelocatableV<T>)
+{
+    assert(heap_.GetAllocator() == other.heap_.GetAllocator());
+    if (!IsInline() && !other.IsInline())
+    {
+        heap_.Swap(other.heap_);
+    }
+    else if (IsInline() && other.IsInline())
+    {
+        SmallVector& shorter = size_ < other.size_ ? *this : other;
+        SmallVector& longer = size_ < other.size_ ? other : *this;
+        std::swap_ranges(shorter.InlineData(), shorter.InlineData() + shorter.size_, longer.InlineData());
+        detail::RelocateN(longer.InlineData() + shorter.size_, longer.size_ - shorter.size_,
+            shorter.InlineData() + shorter.size_);
+    }
+    else
+    {
+        SmallVector& inline_vector = IsInline() ? *this : other;
+        SmallVector& heap_vector = IsInline() ? other : *this;
+        //   ,    , 
+        heap_vector.RelocateInlineFrom(inline_vector);
+        heap_.Swap(other.heap_);
+    }
+    std::swap(size_, other.size_);
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline size_t SmallVector<T, N, Allocator, GrowthPolicy>::Size() const noexcept
+{
+    return size_;
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline size_t SmallVector<T, N, Allocator, GrowthPolicy>::Capacity() const noexcept
+{
+    return IsInline() ? N : heap_.Capacity();
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline bool SmallVector<T, N, Allocator, GrowthPolicy>::IsInline() const noexcept
+{
+    return heap_.Capacity() == 0;
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline Allocator SmallVector<T, N, Allocator, GrowthPolicy>::GetAllocator() const noexcept
+{
+    return heap_.GetAllocator();
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::Reserve(size_t new_capacity)
+{
+    if (new_capacity > Capacity())
+    {
+        Reallocate(new_capacity);
+    }
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::Resize(size_t new_size)
+{
+    if (new_size <= size_)
+    {
+        std::destroy_n(Data() + new_size, size_ - new_size);
+    }
+    else
+    {
+        Reserve(new_size);
+        std::uninitialized_value_construct_n(Data() + size_, new_size - size_);
+    }
+    size_ = new_size;
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::PushBack(const T& value)
+{
+    EmplaceBack(value);
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::PushBack(T&& value)
+{
+    EmplaceBack(std::move(value));
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::PopBack()
+{
+    assert(size_ > 0);
+    std::destroy_at(Data() + size_ - 1);
+    --size_;
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::iterator SmallVector<T, N, Allocator, GrowthPolicy>::Insert(const_iterator pos, const T& value)
+{
+    return Emplace(pos, value);
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::iterator SmallVector<T, N, Allocator, GrowthPolicy>::Insert(const_iterator pos, T&& value)
+{
+    return Emplace(pos, std::move(value));
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::iterator SmallVector<T, N, Allocator, GrowthPolicy>::Erase(const_iterator pos)
+{
+    const size_t id = pos - begin();
+    std::move(begin() + id + 1, end(), begin() + id);
+    std::destroy_at(end() - 1);
+    --size_;
+    return begin() + id;
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+template<typename... Args>
+inline T& SmallVector<T, N, Allocator, GrowthPolicy>::EmplaceBack(Args&&... args)
+{
+    if (size_ < Capacity())
+    {
+        new (Data() + size_) T(std::forward<Args>(args)...);
+    }
+    else
+    {
+        RawMemory<T, Allocator> new_data(NextCapacity(size_ + 1), heap_.GetAllocator());
+        new (new_data + size_) T(std::forward<Args>(args)...);
+        try
+        {
+            detail::RelocateN(Data(), size_, new_data.GetAddress());
+        }
+        catch (...)
+        {
+            std::destroy_at(new_data + size_);
+            throw;
+        }
+        instrumentation::OnReallocate<T>(Capacity(), new_data.Capacity());
+        heap_.Swap(new_data);
+    }
+    ++size_;
+    return Data()[size_ - 1];
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+template<typename... Args>
+inline typename SmallVector<T, N, Allocator, GrowthPolicy>::iterator SmallVector<T, N, Allocator, GrowthPolicy>::Emplace(const_iterator pos, Args&&... args)
+{
+    const size_t id = pos - begin();
+    if (size_ < Capacity())
+    {
+        if (id == size_)
+        {
+            new (end()) T(std::forward<Args>(args)...);
+        }
+        else
+        {
+            T obj(std::forward<Args>(args)...);
+            new (end()) T(std::move(*(end() - 1)));
+            try
+            {
+                std::move_backward(begin() + id, end() - 1, end());
+                Data()[id] = std::move(obj);
+            }
+            catch (...)
+            {
+                //           
+                std::destroy_at(end());
+                throw;
+            }
+        }
+        ++size_;
+        return begin() + id;
+    }
+
+    RawMemory<T, Allocator> new_data(NextCapacity(size_ + 1), heap_.GetAllocator());
+    new (new_data + id) T(std::forward<Args>(args)...);
+    try
+    {
+        detail::UninitializedRelocateN(Data(), id, new_data.GetAddress());
+    }
+    catch (...)
+    {
+        std::destroy_at(new_data + id);
+        throw;
+    }
+    try
+    {
+        detail::UninitializedRelocateN(Data() + id, size_ - id, new_data + (id + 1));
+    }
+    catch (...)
+    {
+        std::destroy_n(new_data.GetAddress(), id + 1);
+        throw;
+    }
+    detail::DestroyRelocatedN(Data(), size_);
+    instrumentation::OnReallocate<T>(Capacity(), new_data.Capacity());
+    heap_.Swap(new_data);
+    ++size_;
+    return begin() + id;
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline const T& SmallVector<T, N, Allocator, GrowthPolicy>::operator[](size_t index) const noexcept
+{
+    return const_cast<SmallVector&>(*this)[index];
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline T& SmallVector<T, N, Allocator, GrowthPolicy>::operator[](size_t index) noexcept
+{
+    assert(index < size_);
+    return Data()[index];
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline SmallVector<T, N, Allocator, GrowthPolicy>::~SmallVector()
+{
+    std::destroy_n(Data(), size_);
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline T* SmallVector<T, N, Allocator, GrowthPolicy>::Data() noexcept
+{
+    return IsInline() ? InlineData() : heap_.GetAddress();
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline const T* SmallVector<T, N, Allocator, GrowthPolicy>::Data() const noexcept
+{
+    return const_cast<SmallVector&>(*this).Data();
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline T* SmallVector<T, N, Allocator, GrowthPolicy>::InlineData() noexcept
+{
+    return reinterpret_cast<T*>(inline_);
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::Reallocate(size_t new_capacity)
+{
+    if (!IsInline() && heap_.TryExpand(new_capacity))
+    {
+        return;
+    }
+    if constexpr (IsTriviallyRelocatableV<T> && RawMemory<T, Allocator>::CAN_REALLOCATE)
+    {
+        if (!IsInline())
+        {
+            heap_.Reallocate(new_capacity);
+            return;
+        }
+    }
+    RawMemory<T, Allocator> new_data(new_capacity, heap_.GetAllocator());
+    detail::RelocateN(Data(), size_, new_data.GetAddress());
+    instrumentation::OnReallocate<T>(Capacity(), new_data.Capacity());
+    heap_.Swap(new_data);
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline void SmallVector<T, N, Allocator, GrowthPolicy>::RelocateInlineFrom(SmallVector& other)
+{
+    detail::RelocateN(other.InlineData(), other.size_, InlineData());
+}
+
+template<typename T, size_t N, typename Allocator, typename GrowthPolicy>
+inline size_t SmallVector<T, N, Allocator, GrowthPolicy>::NextCapacity(size_t required) const noexcept
+{
+    return GrowthPolicy::NextCapacity(Capacity(), required, sizeof(T));
+}
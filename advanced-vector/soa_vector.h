@@ -0,0 +1,440 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "span.h"
+#include "vector.h"
+
+//      :   Ts    
+//  RawMemory.        ,  Column<I>() 
+//     .       :
+//     auto [id, score] = records[i];
+//     ,      .
+//      Vector
+template <typename... Ts>
+class SoAVector {
+    static_assert(sizeof...(Ts) > 0, "SoAVector needs at least one field");
+
+    using Columns = std::tuple<RawMemory<Ts>...>;
+    using Indices = std::index_sequence_for<Ts...>;
+
+public:
+    template <size_t I>
+    using ColumnType = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    using value_type = std::tuple<Ts...>;
+    using reference = std::tuple<Ts&...>;
+    using const_reference = std::tuple<const Ts&...>;
+
+    static constexpr size_t COLUMN_COUNT = sizeof...(Ts);
+
+    SoAVector() = default;
+    explicit SoAVector(size_t size);
+
+    SoAVector(const SoAVector& other);
+    SoAVector& operator=(const SoAVector& rhs);
+
+    SoAVector(SoAVector&& other) noexcept;
+    SoAVector& operator=(SoAVector&& rhs) noexcept;
+
+    void Swap(SoAVector& other) noexcept;
+
+    size_t Size() const noexcept;
+    size_t Capacity() const noexcept;
+
+    void Reserve(size_t new_capacity);
+    void Resize(size_t new_size);
+    void Clear() noexcept;
+
+    //  ,      
+    template <typename... Args>
+    reference EmplaceBack(Args&&... args);
+    void PushBack(const Ts&... values);
+    void PopBack() /* noexcept */;
+    void Erase(size_t index);
+
+    template <size_t I>
+    Span<ColumnType<I>> Column() noexcept;
+    template <size_t I>
+    Span<const ColumnType<I>> Column() const noexcept;
+
+    reference operator[](size_t index) noexcept;
+    const_reference operator[](size_t index) const noexcept;
+
+    ~SoAVector();
+
+private:
+    //     :      
+    template <typename T>
+    static constexpr bool MAY_THROW_ON_RELOCATE = !IsTriviallyRelocatableV<T> && !detail::RelocateByMoveV<T>;
+
+    //  fn(std::integral_constant<size_t, I>{})     
+    template <typename Fn>
+    static void ForEachColumn(Fn&& fn);
+    template <typename Fn, size_t... I>
+    static void ForEachColumn(Fn& fn, std::index_sequence<I...>);
+
+    static Columns AllocateColumns(size_t capacity);
+
+    //   index   columns.     
+    template <typename... Args>
+    static void ConstructRow(Columns& columns, size_t index, Args&&... args);
+    template <size_t... I, typename... Args>
+    static void ConstructFields(Columns& columns, size_t index, std::index_sequence<I...>, Args&&... args);
+
+    static void DestroyRows(Columns& columns, size_t first, size_t last) noexcept;
+
+    //      to.   ,   
+    //  ,       
+    void RelocateTo(Columns& to);
+
+    void Reallocate(size_t new_capacity);
+
+    size_t NextCapacity(size_t required) const noexcept;
+
+private:
+    Columns columns_;
+    size_t size_ = 0;
+};
+
+template<typename... Ts>
+inline SoAVector<Ts...>::SoAVector(size_t size)
+{
+    Resize(size);
+}
+
+template<typename... Ts>
+inline SoAVector<Ts...>::SoAVector(const SoAVector& other)
+    : columns_(AllocateColumns(other.size_))
+{
+    size_t copied = 0;
+    try
+    {
+        ForEachColumn([&](auto column) {
+            constexpr size_t I = decltype(column)::value;
+            std::uninitialized_copy_n(std::get<I>(other.columns_).GetAddress(), other.size_, std::get<I>(columns_).GetAddress());
+            copied = I + 1;
+        });
+    }
+    catch (...)
+    {
+        ForEachColumn([&](auto column) {
+            constexpr size_t I = decltype(column)::value;
+            if (I < copied)
+            {
+                std::destroy_n(std::get<I>(columns_).GetAddress(), other.size_);
+            }
+        });
+        throw;
+    }
+    size_ = other.size_;
+}
+
+template<typename... Ts>
+inline SoAVector<Ts...>& SoAVector<Ts...>::operator=(const SoAVector& rhs)
+{
+    if (this != &rhs)
+    {
+        SoAVector rhs_copy(rhs);
+        Swap(rhs_copy);
+    }
+    return *this;
+}
+
+template<typename... Ts>
+inline SoAVector<Ts...>::SoAVector(SoAVector&& other) noexcept
+    : columns_(std::move(other.columns_))
+    , size_(std::exchange(other.size_, 0))
+{
+}
+
+template<typename... Ts>
+inline SoAVector<Ts...>& SoAVector<Ts...>::operator=(SoAVector&& rhs) noexcept
+{
+    if (this != &rhs)
+    {
+        SoAVector rhs_moved(std::move(rhs));
+        Swap(rhs_moved);
+    }
+    return *this;
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::Swap(SoAVector& other) noexcept
+{
+    ForEachColumn([&](auto column) {
+        constexpr size_t I = decltype(column)::value;
+        std::get<I>(columns_).Swap(std::get<I>(other.columns_));
+    });
+    std::swap(size_, other.size_);
+}
+
+template<typename... Ts>
+inline size_t SoAVector<Ts...>::Size() const noexcept
+{
+    return size_;
+}
+
+template<typename... Ts>
+inline size_t SoAVector<Ts...>::Capacity() const noexcept
+{
+    return std::get<0>(columns_).Capacity();
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::Reserve(size_t new_capacity)
+{
+    if (new_capacity > Capacity())
+    {
+        Reallocate(new_capacity);
+    }
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::Resize(size_t new_size)
+{
+    if (new_size <= size_)
+    {
+        DestroyRows(columns_, new_size, size_);
+        size_ = new_size;
+        return;
+    }
+    Reserve(new_size);
+    size_t constructed = 0;
+    try
+    {
+        ForEachColumn([&](auto column) {
+            constexpr size_t I = decltype(column)::value;
+            std::uninitialized_value_construct_n(std::get<I>(columns_) + size_, new_size - size_);
+            constructed = I + 1;
+        });
+    }
+    catch (...)
+    {
+        ForEachColumn([&](auto column) {
+            constexpr size_t I = decltype(column)::value;
+            if (I < constructed)
+            {
+                std::destroy_n(std::get<I>(columns_) + size_, new_size - size_);
+            }
+        });
+        throw;
+    }
+    size_ = new_size;
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::Clear() noexcept
+{
+    DestroyRows(columns_, 0, size_);
+    size_ = 0;
+}
+
+template<typename... Ts>
+template<typename... Args>
+inline typename SoAVector<Ts...>::reference SoAVector<Ts...>::EmplaceBack(Args&&... args)
+{
+    static_assert(sizeof...(Args) == sizeof...(Ts), "EmplaceBack takes one argument per field");
+    if (size_ == Capacity())
+    {
+        //       ,       
+        Columns new_columns = AllocateColumns(NextCapacity(size_ + 1));
+        ConstructRow(new_columns, size_, std::forward<Args>(args)...);
+        try
+        {
+            RelocateTo(new_columns);
+        }
+        catch (...)
+        {
+            DestroyRows(new_columns, size_, size_ + 1);
+            throw;
+        }
+        columns_.swap(new_columns);
+    }
+    else
+    {
+        ConstructRow(columns_, size_, std::forward<Args>(args)...);
+    }
+    ++size_;
+    return (*this)[size_ - 1];
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::PushBack(const Ts&... values)
+{
+    EmplaceBack(values...);
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::PopBack()
+{
+    assert(size_ > 0);
+    DestroyRows(columns_, size_ - 1, size_);
+    --size_;
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::Erase(size_t index)
+{
+    assert(index < size_);
+    ForEachColumn([&](auto column) {
+        constexpr size_t I = decltype(column)::value;
+        auto* data = std::get<I>(columns_).GetAddress();
+        std::move(data + index + 1, data + size_, data + index);
+    });
+    PopBack();
+}
+
+template<typename... Ts>
+template<size_t I>
+inline Span<typename SoAVector<Ts...>::template ColumnType<I>> SoAVector<Ts...>::Column() noexcept
+{
+    return Span<ColumnType<I>>(std::get<I>(columns_).GetAddress(), size_);
+}
+
+template<typename... Ts>
+template<size_t I>
+inline Span<const typename SoAVector<Ts...>::template ColumnType<I>> SoAVector<Ts...>::Column() const noexcept
+{
+    return Span<const ColumnType<I>>(std::get<I>(columns_).GetAddress(), size_);
+}
+
+template<typename... Ts>
+inline typename SoAVector<Ts...>::reference SoAVector<Ts...>::operator[](size_t index) noexcept
+{
+    assert(index < size_);
+    return std::apply([index](RawMemory<Ts>&... columns) {
+        return reference(columns[index]...);
+    }, columns_);
+}
+
+template<typename... Ts>
+inline typename SoAVector<Ts...>::const_reference SoAVector<Ts...>::operator[](size_t index) const noexcept
+{
+    assert(index < size_);
+    return std::apply([index](const RawMemory<Ts>&... columns) {
+        return const_reference(columns[index]...);
+    }, columns_);
+}
+
+template<typename... Ts>
+inline SoAVector<Ts...>::~SoAVector()
+{
+    DestroyRows(columns_, 0, size_);
+}
+
+template<typename... Ts>
+template<typename Fn>
+inline void SoAVector<Ts...>::ForEachColumn(Fn&& fn)
+{
+    ForEachColumn(fn, Indices{});
+}
+
+template<typename... Ts>
+template<typename Fn, size_t... I>
+inline void SoAVector<Ts...>::ForEachColumn(Fn& fn, std::index_sequence<I...>)
+{
+    (fn(std::integral_constant<size_t, I>{}), ...);
+}
+
+template<typename... Ts>
+inline typename SoAVector<Ts...>::Columns SoAVector<Ts...>::AllocateColumns(size_t capacity)
+{
+    return Columns(RawMemory<Ts>(capacity)...);
+}
+
+template<typename... Ts>
+template<typename... Args>
+inline void SoAVector<Ts...>::ConstructRow(Columns& columns, size_t index, Args&&... args)
+{
+    ConstructFields(columns, index, Indices{}, std::forward<Args>(args)...);
+}
+
+template<typename... Ts>
+template<size_t... I, typename... Args>
+inline void SoAVector<Ts...>::ConstructFields(Columns& columns, size_t index, std::index_sequence<I...>, Args&&... args)
+{
+    size_t constructed = 0;
+    try
+    {
+        ((new (std::get<I>(columns) + index) ColumnType<I>(std::forward<Args>(args)), constructed = I + 1), ...);
+    }
+    catch (...)
+    {
+        ForEachColumn([&](auto column) {
+            constexpr size_t J = decltype(column)::value;
+            if (J < constructed)
+            {
+                std::destroy_at(std::get<J>(columns) + index);
+            }
+        });
+        throw;
+    }
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::DestroyRows(Columns& columns, size_t first, size_t last) noexcept
+{
+    ForEachColumn([&](auto column) {
+        constexpr size_t I = decltype(column)::value;
+        std::destroy_n(std::get<I>(columns) + first, last - first);
+    });
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::RelocateTo(Columns& to)
+{
+    size_t copied = 0;
+    try
+    {
+        ForEachColumn([&](auto column) {
+            constexpr size_t I = decltype(column)::value;
+            if constexpr (MAY_THROW_ON_RELOCATE<ColumnType<I>>)
+            {
+                detail::UninitializedRelocateN(std::get<I>(columns_).GetAddress(), size_, std::get<I>(to).GetAddress());
+            }
+            copied = I + 1;
+        });
+    }
+    catch (...)
+    {
+        ForEachColumn([&](auto column) {
+            constexpr size_t I = decltype(column)::value;
+            if constexpr (MAY_THROW_ON_RELOCATE<ColumnType<I>>)
+            {
+                if (I < copied)
+                {
+                    std::destroy_n(std::get<I>(to).GetAddress(), size_);
+                }
+            }
+        });
+        throw;
+    }
+    //     
+    ForEachColumn([&](auto column) {
+        constexpr size_t I = decltype(column)::value;
+        if constexpr (!MAY_THROW_ON_RELOCATE<ColumnType<I>>)
+        {
+            detail::UninitializedRelocateN(std::get<I>(columns_).GetAddress(), size_, std::get<I>(to).GetAddress());
+        }
+        detail::DestroyRelocatedN(std::get<I>(columns_).GetAddress(), size_);
+    });
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::Reallocate(size_t new_capacity)
+{
+    Columns new_columns = AllocateColumns(new_capacity);
+    RelocateTo(new_columns);
+    columns_.swap(new_columns);
+}
+
+template<typename... Ts>
+inline size_t SoAVector<Ts...>::NextCapacity(size_t required) const noexcept
+{
+    return DoublingGrowth::NextCapacity(Capacity(), required, (sizeof(Ts) + ...));
+}
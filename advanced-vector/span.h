@@ -0,0 +1,68 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+//     ,  std::span  C++20.
+// Span<const T>   Span<T> 
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr Span() noexcept = default;
+    constexpr Span(T* data, size_t size) noexcept
+        : data_(data)
+        , size_(size)  //
+    {
+    }
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& other) noexcept
+        : data_(other.Data())
+        , size_(other.Size())  //
+    {
+    }
+
+    constexpr iterator begin() const noexcept {
+        return data_;
+    }
+    constexpr iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    constexpr T* Data() const noexcept {
+        return data_;
+    }
+    constexpr size_t Size() const noexcept {
+        return size_;
+    }
+    constexpr size_t SizeBytes() const noexcept {
+        return size_ * sizeof(T);
+    }
+    constexpr bool Empty() const noexcept {
+        return size_ == 0;
+    }
+
+    constexpr T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    //   count ,   offset
+    constexpr Span Subspan(size_t offset, size_t count) const noexcept {
+        assert(offset <= size_ && count <= size_ - offset);
+        return Span(data_ + offset, count);
+    }
+    constexpr Span First(size_t count) const noexcept {
+        return Subspan(0, count);
+    }
+    constexpr Span Last(size_t count) const noexcept {
+        return Subspan(size_ - count, count);
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
@@ -0,0 +1,392 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace detail {
+
+    //  StaticVector.     T,     
+    //   ;       new
+    template <typename T, size_t N, bool = std::is_trivial_v<T>>
+    struct StaticStorage {
+        constexpr T* Data() noexcept {
+            return values_;
+        }
+        constexpr const T* Data() const noexcept {
+            return values_;
+        }
+
+        template <typename... Args>
+        constexpr T& Construct(size_t index, Args&&... args) {
+            values_[index] = T(std::forward<Args>(args)...);
+            return values_[index];
+        }
+
+        constexpr void Destroy(size_t, size_t) noexcept {
+        }
+
+        //       ,  
+        //    .   N    memset
+        T values_[N] = {};
+        size_t size_ = 0;
+    };
+
+    template <typename T, size_t N>
+    struct StaticStorage<T, N, false> {
+        T* Data() noexcept {
+            return std::launder(reinterpret_cast<T*>(bytes_));
+        }
+        const T* Data() const noexcept {
+            return std::launder(reinterpret_cast<const T*>(bytes_));
+        }
+
+        template <typename... Args>
+        T& Construct(size_t index, Args&&... args) {
+            return *new (bytes_ + index * sizeof(T)) T(std::forward<Args>(args)...);
+        }
+
+        void Destroy(size_t first, size_t last) noexcept {
+            std::destroy_n(Data() + first, last - first);
+        }
+
+        alignas(T) unsigned char bytes_[N * sizeof(T)];
+        size_t size_ = 0;
+    };
+
+    //  ,    ;    
+    template <typename T, size_t N, bool = std::is_trivially_destructible_v<T>>
+    struct StaticDestroyLayer : StaticStorage<T, N> {
+    };
+
+    template <typename T, size_t N>
+    struct StaticDestroyLayer<T, N, false> : StaticStorage<T, N> {
+        StaticDestroyLayer() = default;
+        StaticDestroyLayer(const StaticDestroyLayer&) = default;
+        StaticDestroyLayer(StaticDestroyLayer&&) = default;
+        StaticDestroyLayer& operator=(const StaticDestroyLayer&) = default;
+        StaticDestroyLayer& operator=(StaticDestroyLayer&&) = default;
+
+        ~StaticDestroyLayer() {
+            this->Destroy(0, this->size_);
+        }
+    };
+
+    //      ,  T   ;  
+    //       
+    template <typename T, size_t N, bool = std::is_trivially_copyable_v<T>>
+    struct StaticCopyLayer : StaticDestroyLayer<T, N> {
+    };
+
+    template <typename T, size_t N>
+    struct StaticCopyLayer<T, N, false> : StaticDestroyLayer<T, N> {
+        StaticCopyLayer() = default;
+
+        StaticCopyLayer(const StaticCopyLayer& other) {
+            std::uninitialized_copy_n(other.Data(), other.size_, this->Data());
+            this->size_ = other.size_;
+        }
+
+        StaticCopyLayer(StaticCopyLayer&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            std::uninitialized_move_n(other.Data(), other.size_, this->Data());
+            this->size_ = other.size_;
+        }
+
+        StaticCopyLayer& operator=(const StaticCopyLayer& rhs) {
+            if (this != &rhs)
+            {
+                Assign(rhs.Data(), rhs.size_);
+            }
+            return *this;
+        }
+
+        StaticCopyLayer& operator=(StaticCopyLayer&& rhs) noexcept(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>) {
+            if (this != &rhs)
+            {
+                Assign(std::make_move_iterator(rhs.Data()), rhs.size_);
+            }
+            return *this;
+        }
+
+        ~StaticCopyLayer() = default;
+
+    private:
+        template <typename InputIt>
+        void Assign(InputIt first, size_t count) {
+            const size_t common = std::min(this->size_, count);
+            for (size_t i = 0; i < common; ++i, ++first)
+            {
+                this->Data()[i] = *first;
+            }
+            if (count < this->size_)
+            {
+                this->Destroy(count, this->size_);
+            }
+            else
+            {
+                std::uninitialized_copy_n(first, count - common, this->Data() + common);
+            }
+            this->size_ = count;
+        }
+    };
+
+}  // namespace detail
+
+//    N,   .    , 
+//     ;    std::length_error.
+//   T      .  T  ,
+//    ,   T     
+template <typename T, size_t N>
+class StaticVector : private detail::StaticCopyLayer<T, N> {
+    static_assert(N > 0, "StaticVector must have non-zero capacity");
+
+    using Base = detail::StaticCopyLayer<T, N>;
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr size_t CAPACITY = N;
+
+    constexpr iterator begin() noexcept;
+    constexpr iterator end() noexcept;
+    constexpr const_iterator begin() const noexcept;
+    constexpr const_iterator end() const noexcept;
+    constexpr const_iterator cbegin() const noexcept;
+    constexpr const_iterator cend() const noexcept;
+
+    StaticVector() = default;
+    constexpr explicit StaticVector(size_t size);
+    constexpr StaticVector(size_t size, const T& value);
+    constexpr StaticVector(std::initializer_list<T> init);
+
+    constexpr size_t Size() const noexcept;
+    static constexpr size_t Capacity() noexcept;
+
+    constexpr void Clear() noexcept;
+    constexpr void Resize(size_t new_size);
+    constexpr void PushBack(const T& value);
+    constexpr void PushBack(T&& value);
+    constexpr void PopBack() /* noexcept */;
+    constexpr iterator Insert(const_iterator pos, const T& value);
+    constexpr iterator Insert(const_iterator pos, T&& value);
+    constexpr iterator Erase(const_iterator pos);
+
+    template <typename... Args>
+    constexpr T& EmplaceBack(Args&&... args);
+    template <typename... Args>
+    constexpr iterator Emplace(const_iterator pos, Args&&... args);
+
+    constexpr const T& operator[](size_t index) const noexcept;
+    constexpr T& operator[](size_t index) noexcept;
+
+private:
+    //  std::length_error,  new_size     
+    static constexpr void CheckSize(size_t new_size);
+};
+
+template<typename T, size_t N>
+inline constexpr typename StaticVector<T, N>::iterator StaticVector<T, N>::begin() noexcept
+{
+    return this->Data();
+}
+
+template<typename T, size_t N>
+inline constexpr typename StaticVector<T, N>::iterator StaticVector<T, N>::end() noexcept
+{
+    return this->Data() + this->size_;
+}
+
+template<typename T, size_t N>
+inline constexpr typename StaticVector<T, N>::const_iterator StaticVector<T, N>::begin() const noexcept
+{
+    return this->Data();
+}
+
+template<typename T, size_t N>
+inline constexpr typename StaticVector<T, N>::const_iterator StaticVector<T, N>::end() const noexcept
+{
+    return this->Data() + this->size_;
+}
+
+template<typename T, size_t N>
+inline constexpr typename StaticVector<T, N>::const_iterator StaticVector<T, N>::cbegin() const noexcept
+{
+    return begin();
+}
+
+template<typename T, size_t N>
+inline constexpr typename StaticVector<T, N>::const_iterator StaticVector<T, N>::cend() const noexcept
+{
+    return end();
+}
+
+template<typename T, size_t N>
+inline constexpr StaticVector<T, N>::StaticVector(size_t size)
+{
+    Resize(size);
+}
+
+template<typename T, size_t N>
+inline constexpr StaticVector<T, N>::StaticVector(size_t size, const T& value)
+{
+    CheckSize(size);
+    for (; this->size_ < size; ++this->size_)
+    {
+        this->Construct(this->size_, value);
+    }
+}
+
+template<typename T, size_t N>
+inline constexpr StaticVector<T, N>::StaticVector(std::initializer_list<T> init)
+{
+    CheckSize(init.size());
+    for (const T& value : init)
+    {
+        this->Construct(this->size_, value);
+        ++this->size_;
+    }
+}
+
+template<typename T, size_t N>
+inline constexpr size_t StaticVector<T, N>::Size() const noexcept
+{
+    return this->size_;
+}
+
+template<typename T, size_t N>
+inline constexpr size_t StaticVector<T, N>::Capacity() noexcept
+{
+    return N;
+}
+
+template<typename T, size_t N>
+inline constexpr void StaticVector<T, N>::Clear() noexcept
+{
+    this->Destroy(0, this->size_);
+    this->size_ = 0;
+}
+
+template<typename T, size_t N>
+inline constexpr void StaticVector<T, N>::Resize(size_t new_size)
+{
+    CheckSize(new_size);
+    if (new_size < this->size_)
+    {
+        this->Destroy(new_size, this->size_);
+        this->size_ = new_size;
+    }
+    for (; this->size_ < new_size; ++this->size_)
+    {
+        this->Construct(this->size_);
+    }
+}
+
+template<typename T, size_t N>
+inline constexpr void StaticVector<T, N>::PushBack(const T& value)
+{
+    EmplaceBack(value);
+}
+
+template<typename T, size_t N>
+inline constexpr void StaticVector<T, N>::PushBack(T&& value)
+{
+    EmplaceBack(std::move(value));
+}
+
+template<typename T, size_t N>
+inline constexpr void StaticVector<T, N>::PopBack()
+{
+    assert(this->size_ > 0);
+    --this->size_;
+    this->Destroy(this->size_, this->size_ + 1);
+}
+
+template<typename T, size_t N>
+inline constexpr typename StaticVector<T, N>::iterator StaticVector<T, N>::Insert(const_iterator pos, const T& value)
+{
+    return Emplace(pos, value);
+}
+
+template<typename T, size_t N>
+inline constexpr typename StaticVector<T, N>::iterator StaticVector<T, N>::Insert(const_iterator pos, T&& value)
+{
+    return Emplace(pos, std::move(value));
+}
+
+template<typename T, size_t N>
+inline constexpr typename StaticVector<T, N>::iterator StaticVector<T, N>::Erase(const_iterator pos)
+{
+    assert(pos >= begin() && pos < end());
+    const size_t id = static_cast<size_t>(pos - begin());
+    T* data = this->Data();
+    for (size_t i = id; i + 1 < this->size_; ++i)
+    {
+        data[i] = std::move(data[i + 1]);
+    }
+    PopBack();
+    return begin() + id;
+}
+
+template<typename T, size_t N>
+template<typename... Args>
+inline constexpr T& StaticVector<T, N>::EmplaceBack(Args&&... args)
+{
+    CheckSize(this->size_ + 1);
+    T& elem = this->Construct(this->size_, std::forward<Args>(args)...);
+    ++this->size_;
+    return elem;
+}
+
+template<typename T, size_t N>
+template<typename... Args>
+inline constexpr typename StaticVector<T, N>::iterator StaticVector<T, N>::Emplace(const_iterator pos, Args&&... args)
+{
+    assert(pos >= begin() && pos <= end());
+    const size_t id = static_cast<size_t>(pos - begin());
+    if (id == this->size_)
+    {
+        EmplaceBack(std::forward<Args>(args)...);
+        return begin() + id;
+    }
+    CheckSize(this->size_ + 1);
+    //      ,     
+    T obj(std::forward<Args>(args)...);
+    T* data = this->Data();
+    this->Construct(this->size_, std::move(data[this->size_ - 1]));
+    ++this->size_;
+    for (size_t i = this->size_ - 2; i > id; --i)
+    {
+        data[i] = std::move(data[i - 1]);
+    }
+    data[id] = std::move(obj);
+    return begin() + id;
+}
+
+template<typename T, size_t N>
+inline constexpr const T& StaticVector<T, N>::operator[](size_t index) const noexcept
+{
+    assert(index < this->size_);
+    return this->Data()[index];
+}
+
+template<typename T, size_t N>
+inline constexpr T& StaticVector<T, N>::operator[](size_t index) noexcept
+{
+    assert(index < this->size_);
+    return this->Data()[index];
+}
+
+template<typename T, size_t N>
+inline constexpr void StaticVector<T, N>::CheckSize(size_t new_size)
+{
+    if (new_size > N)
+    {
+        throw std::length_error("StaticVector capacity exceeded");
+    }
+}
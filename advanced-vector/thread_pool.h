@@ -0,0 +1,310 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//            .   
+//    ,        . ,  
+//  ,     ,    
+//         .
+//     ;       TaskGroup
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // threads == 0     std::thread::hardware_concurrency()
+    explicit ThreadPool(unsigned threads = 0);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    //        
+    ~ThreadPool();
+
+    //   ;   0,     
+    size_t ThreadCount() const noexcept;
+
+    void Submit(Task task);
+
+    //       .  false,   
+    bool RunPendingTask();
+
+    //     .      ,
+    //         ,    
+    static ThreadPool& Default();
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void WorkerLoop(size_t index);
+
+    //     index ( )     ( )
+    bool PopTask(size_t index, Task& task);
+    bool StealTask(size_t start, Task& task);
+
+private:
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> pending_{ 0 };
+    std::atomic<size_t> next_queue_{ 0 };
+    bool stop_ = false;
+
+    //      ,    
+    static inline thread_local ThreadPool* current_pool_ = nullptr;
+    static inline thread_local size_t current_index_ = 0;
+};
+
+//   . Run    , Wait     ,
+//      ,      
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::Default()) noexcept;
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    //  ;     
+    ~TaskGroup();
+
+    template <typename Fn>
+    void Run(Fn&& fn);
+
+    void Wait();
+
+private:
+    void WaitAll() noexcept;
+
+private:
+    ThreadPool& pool_;
+    std::atomic<size_t> pending_{ 0 };
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
+
+inline ThreadPool::ThreadPool(unsigned threads)
+{
+    if (threads == 0)
+    {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    queues_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i)
+    {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i)
+    {
+        try
+        {
+            workers_.emplace_back([this, i] {
+                WorkerLoop(i);
+            });
+        }
+        catch (...)
+        {
+            //          TaskGroup
+            break;
+        }
+    }
+}
+
+inline ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard guard(wake_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_)
+    {
+        worker.join();
+    }
+    // ,   ,  
+    while (RunPendingTask())
+    {
+    }
+}
+
+inline size_t ThreadPool::ThreadCount() const noexcept
+{
+    return workers_.size();
+}
+
+inline void ThreadPool::Submit(Task task)
+{
+    const size_t index = current_pool_ == this
+        ? current_index_
+        : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    {
+        //     : ,  ,     
+        std::lock_guard guard(wake_mutex_);
+        pending_.fetch_add(1, std::memory_order_relaxed);
+    }
+    try
+    {
+        Queue& queue = *queues_[index];
+        std::lock_guard guard(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    catch (...)
+    {
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+    wake_.notify_one();
+}
+
+inline bool ThreadPool::RunPendingTask()
+{
+    Task task;
+    const bool found = current_pool_ == this
+        ? PopTask(current_index_, task)
+        : StealTask(next_queue_.load(std::memory_order_relaxed), task);
+    if (found)
+    {
+        task();
+    }
+    return found;
+}
+
+inline ThreadPool& ThreadPool::Default()
+{
+    static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+    return pool;
+}
+
+inline void ThreadPool::WorkerLoop(size_t index)
+{
+    current_pool_ = this;
+    current_index_ = index;
+    Task task;
+    while (true)
+    {
+        if (PopTask(index, task))
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock lock(wake_mutex_);
+        wake_.wait(lock, [this] {
+            return stop_ || pending_.load(std::memory_order_relaxed) != 0;
+        });
+        if (stop_ && pending_.load(std::memory_order_relaxed) == 0)
+        {
+            return;
+        }
+    }
+}
+
+inline bool ThreadPool::PopTask(size_t index, Task& task)
+{
+    {
+        Queue& queue = *queues_[index];
+        std::lock_guard guard(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return StealTask(index + 1, task);
+}
+
+inline bool ThreadPool::StealTask(size_t start, Task& task)
+{
+    if (pending_.load(std::memory_order_relaxed) == 0)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < queues_.size(); ++i)
+    {
+        Queue& queue = *queues_[(start + i) % queues_.size()];
+        std::lock_guard guard(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            pending_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+inline TaskGroup::TaskGroup(ThreadPool& pool) noexcept
+    : pool_(pool)
+{
+}
+
+inline TaskGroup::~TaskGroup()
+{
+    WaitAll();
+}
+
+template<typename Fn>
+inline void TaskGroup::Run(Fn&& fn)
+{
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    try
+    {
+        pool_.Submit([this, fn = std::forward<Fn>(fn)]() mutable {
+            try
+            {
+                fn();
+            }
+            catch (...)
+            {
+                std::lock_guard guard(error_mutex_);
+                if (!error_)
+                {
+                    error_ = std::current_exception();
+                }
+            }
+            //       
+            pending_.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    catch (...)
+    {
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+}
+
+inline void TaskGroup::Wait()
+{
+    WaitAll();
+    if (error_)
+    {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+inline void TaskGroup::WaitAll() noexcept
+{
+    while (pending_.load(std::memory_order_acquire) != 0)
+    {
+        if (!pool_.RunPendingTask())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
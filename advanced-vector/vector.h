@@ -1,22 +1,179 @@
 #pragma once
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
 #include <new>
 #include <utility>
 #include <memory>
 #include <algorithm>
+#include <initializer_list>
+#include <iterator>
+#include <memory_resource>
+#include <stdexcept>
+
+#include "checks.h"
+#include "growth_policy.h"
+#include "parallel.h"
+#include "relocation.h"
+#include "simd.h"
+#include "span.h"
+
+namespace detail {
+
+    //      : bool TryExpand(T* ptr, size_t old_n, size_t new_n)
+    template <typename Allocator, typename = void>
+    struct HasTryExpand : std::false_type {
+    };
+
+    template <typename Allocator>
+    struct HasTryExpand<Allocator, std::void_t<decltype(std::declval<bool&>() = std::declval<Allocator&>().TryExpand(
+        std::declval<typename Allocator::value_type*>(), size_t{}, size_t{}))>> : std::true_type {
+    };
+
+    //        ,  realloc:
+    // T* Reallocate(T* ptr, size_t old_n, size_t new_n)
+    template <typename Allocator, typename = void>
+    struct HasReallocate : std::false_type {
+    };
+
+    template <typename Allocator>
+    struct HasReallocate<Allocator, std::void_t<decltype(std::declval<typename Allocator::value_type*&>() = std::declval<Allocator&>().Reallocate(
+        std::declval<typename Allocator::value_type*>(), size_t{}, size_t{}))>> : std::true_type {
+    };
+
+    //     : static size_t GoodCapacity(size_t n) 
+    //  ,   n,     
+    template <typename Allocator, typename = void>
+    struct HasGoodCapacity : std::false_type {
+    };
+
+    template <typename Allocator>
+    struct HasGoodCapacity<Allocator, std::void_t<decltype(std::declval<size_t&>() = Allocator::GoodCapacity(size_t()))>>
+        : std::true_type {
+    };
+
+    //   : Allocator::ALIGNMENT,   ,  alignof(T)
+    template <typename T, typename Allocator, typename = void>
+    struct AllocatorAlignment : std::integral_constant<size_t, alignof(T)> {
+    };
+
+    template <typename T, typename Allocator>
+    struct AllocatorAlignment<T, Allocator, std::void_t<decltype(Allocator::ALIGNMENT)>>
+        : std::integral_constant<size_t, (Allocator::ALIGNMENT > alignof(T) ? Allocator::ALIGNMENT : alignof(T))> {
+    };
+
+    template <typename It, typename = void>
+    struct IsInputIterator : std::false_type {
+    };
+
+    template <typename It>
+    struct IsInputIterator<It, std::enable_if_t<std::is_convertible_v<
+        typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag>>> : std::true_type {
+    };
+
+    template <typename It>
+    inline constexpr bool IsInputIteratorV = IsInputIterator<It>::value;
+
+    template <typename It>
+    inline constexpr bool IsForwardIteratorV = std::is_convertible_v<
+        typename std::iterator_traits<It>::iterator_category, std::forward_iterator_tag>;
+
+    //         ,  count 
+    template <typename T>
+    class RepeatIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        RepeatIterator(const T& value, size_t index) noexcept
+            : value_(&value)
+            , index_(index) {
+        }
+
+        reference operator*() const noexcept {
+            return *value_;
+        }
+        pointer operator->() const noexcept {
+            return value_;
+        }
+        RepeatIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        RepeatIterator operator++(int) noexcept {
+            RepeatIterator old = *this;
+            ++index_;
+            return old;
+        }
+        bool operator==(const RepeatIterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+        bool operator!=(const RepeatIterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+
+    private:
+        const T* value_;
+        size_t index_;
+    };
+
+    //         [first, last),   
+    //    
+    template <typename T, typename... Args>
+    bool AnyArgumentInRange([[maybe_unused]] const T* first, [[maybe_unused]] const T* last, const Args&... args) noexcept {
+        using Less = std::less<const void*>;
+        return (false || ... || (!Less()(std::addressof(args), first) && Less()(std::addressof(args), last)));
+    }
+
+}  // namespace detail
+
+//  ,       value-:
+//      
+struct DefaultInitTag {
+};
+inline constexpr DefaultInitTag DEFAULT_INIT{};
+
+//  ,       
+struct AdoptBufferTag {
+};
+inline constexpr AdoptBufferTag ADOPT_BUFFER{};
+
+//      T,    .
+//  ,    ,   
+// std::pmr::polymorphic_allocator.      
+template <typename T, typename Allocator = std::allocator<T>>
+class RawMemory : private Allocator {
+    using AllocTraits = std::allocator_traits<Allocator>;
+    static_assert(std::is_same_v<typename AllocTraits::value_type, T>, "Allocator::value_type must be T");
+    static_assert(std::is_same_v<typename AllocTraits::pointer, T*>, "Fancy pointers are not supported");
 
-template <typename T>
-class RawMemory {
 public:
+    using allocator_type = Allocator;
+
+    //      Reallocate
+    static constexpr bool CAN_REALLOCATE = detail::HasReallocate<Allocator>::value;
+    // ,     
+    static constexpr size_t ALIGNMENT = detail::AllocatorAlignment<T, Allocator>::value;
+
     RawMemory() = default;
 
-    explicit RawMemory(size_t capacity);
+    explicit RawMemory(const Allocator& alloc) noexcept;
+    explicit RawMemory(size_t capacity, const Allocator& alloc = Allocator());
+    //      capacity,  ,  alloc.
+    //   instrumentation     ,   Release  ,
+    //       
+    RawMemory(T* buffer, size_t capacity, const Allocator& alloc = Allocator()) noexcept;
 
     RawMemory(const RawMemory&) = delete;
     RawMemory& operator=(const RawMemory& rhs) = delete;
 
     RawMemory(RawMemory&& other) noexcept;
+    //      
     RawMemory& operator=(RawMemory&& rhs) noexcept;
 
     ~RawMemory();
@@ -27,30 +184,101 @@ public:
     const T& operator[](size_t index) const noexcept;
     T& operator[](size_t index) noexcept;
 
+    //  ,   .     ,
+    //   ,        
     void Swap(RawMemory& other) noexcept;
 
     const T* GetAddress() const noexcept;
 
     T* GetAddress() noexcept;
 
+    //        .   ,
+    //     ,  GetAllocator()
+    T* Release() noexcept;
+
     size_t Capacity() const;
 
+    //     new_capacity,     .
+    //     ,      T
+    bool TryExpand(size_t new_capacity) noexcept;
+
+    //    new_capacity    (, realloc),
+    //   . ,      .
+    //     
+    void Reallocate(size_t new_capacity);
+
+    const Allocator& GetAllocator() const noexcept;
+    Allocator& GetAllocator() noexcept;
+
+    //  ,   n ,    
+    static size_t RoundCapacity(size_t n) noexcept;
+
 private:
     //     n      
-    static T* Allocate(size_t n);
+    T* Allocate(size_t n);
 
-    //   ,     buf   Allocate
-    static void Deallocate(T* buf) noexcept;
+    //     n ,     buf   Allocate
+    void Deallocate(T* buf, size_t n) noexcept;
 
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
 };
 
-template <typename T>
-class Vector {
+//    capacity,   .    
+//  .   deleter  std::unique_ptr<T[], BufferDeallocator<T, Allocator>>
+template <typename T, typename Allocator = std::allocator<T>>
+class BufferDeallocator : private Allocator {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+public:
+    BufferDeallocator() = default;
+    BufferDeallocator(size_t capacity, const Allocator& alloc) noexcept
+        : Allocator(alloc)
+        , capacity_(capacity) {
+    }
+
+    void operator()(T* buffer) noexcept {
+        if (buffer != nullptr)
+        {
+            AllocTraits::deallocate(GetAllocator(), buffer, capacity_);
+        }
+    }
+
+    const Allocator& GetAllocator() const noexcept {
+        return *this;
+    }
+    Allocator& GetAllocator() noexcept {
+        return *this;
+    }
+
+    size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+private:
+    size_t capacity_ = 0;
+};
+
+// ,   Vector  Release:  size  ,  
+//  capacity      deallocator(data)
+template <typename T, typename Allocator = std::allocator<T>>
+struct ReleasedBuffer {
+    T* data = nullptr;
+    size_t size = 0;
+    size_t capacity = 0;
+    BufferDeallocator<T, Allocator> deallocator;
+};
+
+//     T. GrowthPolicy      .
+//       ADVANCED_VECTOR_HARDENED  ADVANCED_VECTOR_CHECKED (. checks.h)
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+class Vector : private detail::GenerationCounter<> {
+    using AllocTraits = std::allocator_traits<Allocator>;
+
 public:
-    using iterator = T*;
-    using const_iterator = const T*;
+    using iterator = std::conditional_t<CHECKED_ITERATORS, detail::CheckedIterator<T, Vector>, T*>;
+    using const_iterator = std::conditional_t<CHECKED_ITERATORS, detail::CheckedIterator<const T, Vector>, const T*>;
+    using allocator_type = Allocator;
 
     iterator begin() noexcept;
     iterator end() noexcept;
@@ -60,39 +288,138 @@ public:
     const_iterator cend() const noexcept;
 
     Vector() = default;
-    explicit Vector(size_t size);
+    explicit Vector(const Allocator& alloc) noexcept;
+    explicit Vector(size_t size, const Allocator& alloc = Allocator());
+    Vector(size_t size, const T& value, const Allocator& alloc = Allocator());
+    Vector(size_t size, DefaultInitTag, const Allocator& alloc = Allocator());
+    Vector(std::initializer_list<T> init, const Allocator& alloc = Allocator());
+    //     data  capacity  size    .
+    //     ,  alloc,   capacity 
+    Vector(AdoptBufferTag, T* data, size_t size, size_t capacity, const Allocator& alloc = Allocator()) noexcept;
+    explicit Vector(ReleasedBuffer<T, Allocator>&& buffer) noexcept;
+    //      :   
+    //   ,      
+    Vector(ParallelTag, size_t size, const Allocator& alloc = Allocator());
+    Vector(ParallelTag, const Vector& other);
 
     Vector(const Vector& other);
+    Vector(const Vector& other, const Allocator& alloc);
     Vector& operator=(const Vector& rhs);
 
     Vector(Vector&& other) noexcept;
-    Vector& operator=(Vector&& rhs) noexcept;
+    Vector(Vector&& other, const Allocator& alloc);
+    Vector& operator=(Vector&& rhs) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+        || AllocTraits::is_always_equal::value);
 
+    //  ,     propagate_on_container_swap,
+    //       
     void Swap(Vector& other) noexcept;
 
+    Allocator GetAllocator() const noexcept;
+
     size_t Size() const noexcept;
     size_t Capacity() const noexcept;
 
+    T* Data() noexcept;
+    const T* Data() const noexcept;
+    //   .    
+    Span<T> AsSpan() noexcept;
+    Span<const T> AsSpan() const noexcept;
+    Span<T> Subspan(size_t offset, size_t count) noexcept;
+    Span<const T> Subspan(size_t offset, size_t count) const noexcept;
+
+    //       .   
+    //   ,  
+    [[nodiscard]] ReleasedBuffer<T, Allocator> Release() noexcept;
+
     void Reserve(size_t new_capacity);
+    //     ,   
+    void ShrinkToFit();
+    //   ,        min_load .
+    //  true,    
+    bool Trim(double min_load = 0.25);
+    //   ,  
+    void Clear() noexcept;
     void Resize(size_t new_size);
+    //  Resize,      ,    
+    //      .     
+    void ResizeDefaultInit(size_t new_size);
+    //    new_size,    .   
+    // op(T* tail, size_t count)        
+    //    (  count),    .
+    //   op  .     
+    template <typename Operation>
+    void ResizeAndOverwrite(size_t new_size, Operation op);
+    //    , Resize  Clear.  
+    //    . ParallelCopyFrom     
+    //    
+    void ParallelCopyFrom(const Vector& other);
+    void ParallelResize(size_t new_size);
+    void ParallelClear() noexcept;
     void PushBack(const T& value);
     void PushBack(T&& value);
     void PopBack() /* noexcept */;
     iterator Insert(const_iterator pos, const T& value);
     iterator Insert(const_iterator pos, T&& value);
+    //  count  value  pos
+    iterator Insert(const_iterator pos, size_t count, const T& value);
+    //    [first, last)  pos.     
+    //  ,       ,   
+    // .        
+    template <typename InputIt, typename = std::enable_if_t<detail::IsInputIteratorV<InputIt>>>
+    iterator Insert(const_iterator pos, InputIt first, InputIt last);
+    template <typename InputIt, typename = std::enable_if_t<detail::IsInputIteratorV<InputIt>>>
+    void Append(InputIt first, InputIt last);
+    //      [first, last),  ,   
+    template <typename InputIt, typename = std::enable_if_t<detail::IsInputIteratorV<InputIt>>>
+    void Assign(InputIt first, InputIt last);
+    //    count  value
+    void Assign(size_t count, const T& value);
     iterator Erase(const_iterator pos);
+    //   [first, last)    
+    iterator Erase(const_iterator first, const_iterator last);
 
     template <typename... Args>
     T& EmplaceBack(Args&&... args);
     template <typename... Args>
     iterator Emplace(const_iterator pos, Args&&... args);
 
+    //  .     (. IsBitwiseComparable) 
+    //  ,   
+    iterator Find(const T& value);
+    const_iterator Find(const T& value) const;
+    size_t Count(const T& value) const;
+    bool Contains(const T& value) const;
+
     const T& operator[](size_t index) const noexcept;
     T& operator[](size_t index) noexcept;
+    //       .  std::out_of_range
+    const T& At(size_t index) const;
+    T& At(size_t index);
 
     ~Vector();
 
+    template <typename U, typename A, typename G, typename Predicate>
+    friend size_t EraseIf(Vector<U, A, G>& vector, Predicate pred);
+
 private:
+    friend iterator;
+    friend const_iterator;
+
+    //    index,    
+    iterator MakeIterator(size_t index) noexcept;
+    const_iterator MakeIterator(size_t index) const noexcept;
+
+    //   pos  [0, size_].   CHECKED ,   
+    //    
+    size_t IndexOf(const_iterator pos) const noexcept;
+
+    //     .       
+    //   ;        
+    void InvalidateIterators() noexcept;
+
+    uint64_t IteratorGeneration() const noexcept;
+
     //   n     buf
     static void DestroyN(T* buf, size_t n) noexcept;
 
@@ -104,460 +431,1440 @@ private:
     //      buf
     static void Destroy(T* buf) noexcept;
 
+    //      new_capacity,    
+    void Reallocate(size_t new_capacity);
+
+    //  count ,    ,   first
+    template <typename ForwardIt>
+    iterator InsertN(size_t id, ForwardIt first, size_t count);
+
+    //     id < size_,      .
+    //    
+    template <typename... Args>
+    void EmplaceShift(size_t id, Args&&... args);
+
+    // ,    ,      required 
+    size_t NextCapacity(size_t required) const noexcept;
+
+    //  ,     Propagate
+    template <typename Propagate>
+    static void SwapAllocatorsIf(Allocator& lhs, Allocator& rhs) noexcept;
+
 private:
-    RawMemory<T> data_;
+    RawMemory<T, Allocator> data_;
     size_t size_ = 0;
 };
 
-template<typename T>
-inline RawMemory<T>::RawMemory(size_t capacity)
-    : buffer_(Allocate(capacity))
-    , capacity_(capacity) {
+template<typename T, typename Allocator>
+inline RawMemory<T, Allocator>::RawMemory(const Allocator& alloc) noexcept
+    : Allocator(alloc) {
+}
+
+template<typename T, typename Allocator>
+inline RawMemory<T, Allocator>::RawMemory(size_t capacity, const Allocator& alloc)
+    : Allocator(alloc)
+    , buffer_(Allocate(RoundCapacity(capacity)))
+    , capacity_(RoundCapacity(capacity)) {
+}
+
+template<typename T, typename Allocator>
+inline RawMemory<T, Allocator>::RawMemory(T* buffer, size_t capacity, const Allocator& alloc) noexcept
+    : Allocator(alloc)
+    , buffer_(buffer)
+    , capacity_(buffer != nullptr ? capacity : 0)
+{
+    if (buffer_ != nullptr)
+    {
+        instrumentation::OnAllocate<T>(capacity_);
+    }
 }
 
-template<typename T>
-inline RawMemory<T>::RawMemory(RawMemory&& other) noexcept
-    : buffer_(std::move(other.buffer_)), capacity_(std::move(other.capacity_))
+template<typename T, typename Allocator>
+inline RawMemory<T, Allocator>::RawMemory(RawMemory&& other) noexcept
+    : Allocator(std::move(other.GetAllocator()))
+    , buffer_(std::exchange(other.buffer_, nullptr))
+    , capacity_(std::exchange(other.capacity_, 0))
 {
-    other.buffer_ = nullptr;
-    other.capacity_ = 0;
 }
 
-template<typename T>
-inline RawMemory<T>& RawMemory<T>::operator=(RawMemory&& rhs) noexcept
+template<typename T, typename Allocator>
+inline RawMemory<T, Allocator>& RawMemory<T, Allocator>::operator=(RawMemory&& rhs) noexcept
 {
-    buffer_ = std::move(rhs.buffer_);
-    capacity_ = std::move(rhs.capacity_);
-    rhs.buffer_ = nullptr;
-    rhs.capacity_ = 0;
+    if (this != &rhs)
+    {
+        assert(GetAllocator() == rhs.GetAllocator());
+        Deallocate(buffer_, capacity_);
+        buffer_ = std::exchange(rhs.buffer_, nullptr);
+        capacity_ = std::exchange(rhs.capacity_, 0);
+    }
     return *this;
 }
 
-template<typename T>
-inline RawMemory<T>::~RawMemory()
+template<typename T, typename Allocator>
+inline RawMemory<T, Allocator>::~RawMemory()
 {
-    Deallocate(buffer_);
+    Deallocate(buffer_, capacity_);
 }
 
-template<typename T>
-inline T* RawMemory<T>::operator+(size_t offset) noexcept
+template<typename T, typename Allocator>
+inline T* RawMemory<T, Allocator>::operator+(size_t offset) noexcept
 {
     //     ,     
     assert(offset <= capacity_);
     return buffer_ + offset;
 }
 
-template<typename T>
-inline const T* RawMemory<T>::operator+(size_t offset) const noexcept
+template<typename T, typename Allocator>
+inline const T* RawMemory<T, Allocator>::operator+(size_t offset) const noexcept
 {
     return const_cast<RawMemory&>(*this) + offset;
 }
 
-template<typename T>
-inline const T& RawMemory<T>::operator[](size_t index) const noexcept
+template<typename T, typename Allocator>
+inline const T& RawMemory<T, Allocator>::operator[](size_t index) const noexcept
 {
     return const_cast<RawMemory&>(*this)[index];
 }
 
-template<typename T>
-inline T& RawMemory<T>::operator[](size_t index) noexcept
+template<typename T, typename Allocator>
+inline T& RawMemory<T, Allocator>::operator[](size_t index) noexcept
 {
     assert(index < capacity_);
     return buffer_[index];
 }
 
-template<typename T>
-inline void RawMemory<T>::Swap(RawMemory& other) noexcept
+template<typename T, typename Allocator>
+inline void RawMemory<T, Allocator>::Swap(RawMemory& other) noexcept
 {
     std::swap(buffer_, other.buffer_);
     std::swap(capacity_, other.capacity_);
 }
 
-template<typename T>
-inline const T* RawMemory<T>::GetAddress() const noexcept
+template<typename T, typename Allocator>
+inline const T* RawMemory<T, Allocator>::GetAddress() const noexcept
 {
     return buffer_;
 }
 
-template<typename T>
-inline T* RawMemory<T>::GetAddress() noexcept
+template<typename T, typename Allocator>
+inline T* RawMemory<T, Allocator>::GetAddress() noexcept
 {
     return buffer_;
 }
 
-template<typename T>
-inline size_t RawMemory<T>::Capacity() const
+template<typename T, typename Allocator>
+inline T* RawMemory<T, Allocator>::Release() noexcept
+{
+    if (buffer_ != nullptr)
+    {
+        instrumentation::OnDeallocate<T>();
+    }
+    capacity_ = 0;
+    return std::exchange(buffer_, nullptr);
+}
+
+template<typename T, typename Allocator>
+inline size_t RawMemory<T, Allocator>::Capacity() const
 {
     return capacity_;
 }
 
-template<typename T>
-inline T* RawMemory<T>::Allocate(size_t n)
+template<typename T, typename Allocator>
+inline bool RawMemory<T, Allocator>::TryExpand(size_t new_capacity) noexcept
 {
-    return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    if constexpr (detail::HasTryExpand<Allocator>::value)
+    {
+        if (buffer_ != nullptr && GetAllocator().TryExpand(buffer_, capacity_, new_capacity))
+        {
+            instrumentation::OnReallocate<T>(capacity_, new_capacity);
+            capacity_ = new_capacity;
+            return true;
+        }
+    }
+    return false;
 }
 
-template<typename T>
-inline void RawMemory<T>::Deallocate(T* buf) noexcept
+template<typename T, typename Allocator>
+inline void RawMemory<T, Allocator>::Reallocate(size_t new_capacity)
 {
-    operator delete(buf);
+    static_assert(CAN_REALLOCATE, "Allocator does not support Reallocate");
+    static_assert(IsTriviallyRelocatableV<T>, "Only trivially relocatable elements can be moved bytewise");
+    new_capacity = RoundCapacity(new_capacity);
+    if (buffer_ == nullptr)
+    {
+        buffer_ = Allocate(new_capacity);
+    }
+    else
+    {
+        buffer_ = GetAllocator().Reallocate(buffer_, capacity_, new_capacity);
+        instrumentation::OnReallocate<T>(capacity_, new_capacity);
+    }
+    capacity_ = new_capacity;
 }
 
-template<typename T>
-inline typename Vector<T>::iterator Vector<T>::begin() noexcept
+template<typename T, typename Allocator>
+inline const Allocator& RawMemory<T, Allocator>::GetAllocator() const noexcept
 {
-    return data_.GetAddress();
+    return *this;
 }
 
-template<typename T>
-inline typename Vector<T>::iterator Vector<T>::end() noexcept
+template<typename T, typename Allocator>
+inline Allocator& RawMemory<T, Allocator>::GetAllocator() noexcept
 {
-    return data_ + size_;
+    return *this;
 }
 
-template<typename T>
-inline typename Vector<T>::const_iterator Vector<T>::begin() const noexcept
+template<typename T, typename Allocator>
+inline size_t RawMemory<T, Allocator>::RoundCapacity(size_t n) noexcept
 {
-    return data_.GetAddress();
+    if constexpr (detail::HasGoodCapacity<Allocator>::value)
+    {
+        return n != 0 ? Allocator::GoodCapacity(n) : 0;
+    }
+    else
+    {
+        return n;
+    }
 }
 
-template<typename T>
-inline typename Vector<T>::const_iterator Vector<T>::end() const noexcept
+template<typename T, typename Allocator>
+inline T* RawMemory<T, Allocator>::Allocate(size_t n)
 {
-    return data_ + size_;
+    if (n == 0)
+    {
+        return nullptr;
+    }
+    T* buf = AllocTraits::allocate(GetAllocator(), n);
+    assert(reinterpret_cast<std::uintptr_t>(buf) % ALIGNMENT == 0);
+    instrumentation::OnAllocate<T>(n);
+    return buf;
 }
 
-template<typename T>
-inline typename Vector<T>::const_iterator Vector<T>::cbegin() const noexcept
+template<typename T, typename Allocator>
+inline void RawMemory<T, Allocator>::Deallocate(T* buf, size_t n) noexcept
 {
-    return data_.GetAddress();
+    if (buf != nullptr)
+    {
+        AllocTraits::deallocate(GetAllocator(), buf, n);
+        instrumentation::OnDeallocate<T>();
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::begin() noexcept
+{
+    return MakeIterator(0);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::end() noexcept
+{
+    return MakeIterator(size_);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy>::const_iterator Vector<T, Allocator, GrowthPolicy>::begin() const noexcept
+{
+    return MakeIterator(0);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy>::const_iterator Vector<T, Allocator, GrowthPolicy>::end() const noexcept
+{
+    return MakeIterator(size_);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy>::const_iterator Vector<T, Allocator, GrowthPolicy>::cbegin() const noexcept
+{
+    return MakeIterator(0);
 }
 
-template<typename T>
-inline typename Vector<T>::const_iterator Vector<T>::cend() const noexcept
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy>::const_iterator Vector<T, Allocator, GrowthPolicy>::cend() const noexcept
 {
-    return data_ + size_;
+    return MakeIterator(size_);
 }
 
-template<typename T>
-inline Vector<T>::Vector(size_t size)
-    : data_(size)
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>::Vector(const Allocator& alloc) noexcept
+    : data_(alloc)
+{
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>::Vector(size_t size, const Allocator& alloc)
+    : data_(size, alloc)
     , size_(size)
 {
     std::uninitialized_value_construct_n(data_.GetAddress(), size);
 }
 
-template<typename T>
-inline Vector<T>::Vector(const Vector& other)
-    : data_(other.size_)
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>::Vector(size_t size, const T& value, const Allocator& alloc)
+    : data_(size, alloc)
+    , size_(size)
+{
+    detail::UninitializedFillN(data_.GetAddress(), size, value);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>::Vector(size_t size, DefaultInitTag, const Allocator& alloc)
+    : data_(size, alloc)
+    , size_(size)
+{
+    std::uninitialized_default_construct_n(data_.GetAddress(), size);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>::Vector(std::initializer_list<T> init, const Allocator& alloc)
+    : data_(init.size(), alloc)
+    , size_(init.size())
+{
+    std::uninitialized_copy_n(init.begin(), init.size(), data_.GetAddress());
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>::Vector(AdoptBufferTag, T* data, size_t size, size_t capacity, const Allocator& alloc) noexcept
+    : data_(data, capacity, alloc)
+    , size_(size)
+{
+    assert(size <= capacity && (data != nullptr || size == 0));
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>::Vector(ReleasedBuffer<T, Allocator>&& buffer) noexcept
+    : Vector(ADOPT_BUFFER, std::exchange(buffer.data, nullptr), std::exchange(buffer.size, 0), std::exchange(buffer.capacity, 0),
+        buffer.deallocator.GetAllocator())
+{
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>::Vector(ParallelTag, size_t size, const Allocator& alloc)
+    : data_(size, alloc)
+    , size_(size)
+{
+    detail::ParallelUninitialized(data_.GetAddress(), size, [this](size_t first, size_t last) {
+        std::uninitialized_value_construct_n(data_ + first, last - first);
+    });
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>::Vector(ParallelTag, const Vector& other)
+    : data_(other.size_, AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator()))
+    , size_(other.size_)
+{
+    detail::ParallelUninitialized(data_.GetAddress(), size_, [this, &other](size_t first, size_t last) {
+        std::uninitialized_copy_n(other.data_ + first, last - first, data_ + first);
+    });
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>::Vector(const Vector& other)
+    : Vector(other, AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator()))
+{
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>::Vector(const Vector& other, const Allocator& alloc)
+    : data_(other.size_, alloc)
     , size_(other.size_)
 {
     std::uninitialized_copy_n(other.data_.GetAddress(), other.size_, data_.GetAddress());
 }
 
-template<typename T>
-inline Vector<T>& Vector<T>::operator=(const Vector& rhs)
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>& Vector<T, Allocator, GrowthPolicy>::operator=(const Vector& rhs)
 {
     if (this != &rhs)
     {
+        InvalidateIterators();
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value)
+        {
+            if (data_.GetAllocator() != rhs.data_.GetAllocator())
+            {
+                //    :     
+                Vector rhs_copy(rhs, rhs.data_.GetAllocator());
+                SwapAllocatorsIf<std::true_type>(data_.GetAllocator(), rhs_copy.data_.GetAllocator());
+                data_.Swap(rhs_copy.data_);
+                std::swap(size_, rhs_copy.size_);
+                return *this;
+            }
+        }
         if (data_.Capacity() >= rhs.size_)
         {
-            if (rhs.size_ < size_)
+            if constexpr (std::is_trivially_copyable_v<T>)
             {
-                for (size_t i = 0; i < rhs.size_; i++) {
-                    data_[i] = rhs.data_[i];
-                }
-                for (size_t i = rhs.size_; i < size_; i++)
+                //       ,  
+                if (rhs.size_ != 0)
                 {
-                    Destroy(data_.GetAddress() + i);
+                    std::memcpy(static_cast<void*>(data_.GetAddress()), static_cast<const void*>(rhs.data_.GetAddress()), rhs.size_ * sizeof(T));
                 }
-                size_ = rhs.size_;
             }
             else
             {
-                for (size_t i = 0; i < size_; i++)
+                const size_t common = std::min(size_, rhs.size_);
+                std::copy_n(rhs.data_.GetAddress(), common, data_.GetAddress());
+                if (rhs.size_ < size_)
+                {
+                    std::destroy_n(data_ + rhs.size_, size_ - rhs.size_);
+                }
+                else
                 {
-                    data_[i] = rhs.data_[i];
+                    std::uninitialized_copy_n(rhs.data_ + size_, rhs.size_ - size_, data_ + size_);
                 }
-                std::uninitialized_copy(rhs.data_.GetAddress() + size_, rhs.data_.GetAddress() + rhs.size_, data_.GetAddress() + size_);
-                size_ = rhs.size_;
             }
+            size_ = rhs.size_;
         }
         else
         {
-            Vector rhs_copy(rhs);
-            Swap(rhs_copy);
+            //    rhs   ;     
+            RawMemory<T, Allocator> new_data(rhs.size_, data_.GetAllocator());
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                std::memcpy(static_cast<void*>(new_data.GetAddress()), static_cast<const void*>(rhs.data_.GetAddress()), rhs.size_ * sizeof(T));
+            }
+            else
+            {
+                std::uninitialized_copy_n(rhs.data_.GetAddress(), rhs.size_, new_data.GetAddress());
+            }
+            DestroyN(data_.GetAddress(), size_);
+            data_.Swap(new_data);
+            size_ = rhs.size_;
         }
     }
     return *this;
 }
 
-template<typename T>
-inline Vector<T>::Vector(Vector&& other) noexcept
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>::Vector(Vector&& other) noexcept
     : data_(std::move(other.data_))
     , size_(std::move(other.size_))
 {
     other.size_ = 0;
+    other.InvalidateIterators();
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>::Vector(Vector&& other, const Allocator& alloc)
+    : data_(alloc)
+{
+    other.InvalidateIterators();
+    if (data_.GetAllocator() == other.data_.GetAllocator())
+    {
+        data_.Swap(other.data_);
+        std::swap(size_, other.size_);
+    }
+    else
+    {
+        //     ,     
+        RawMemory<T, Allocator> new_data(other.size_, alloc);
+        std::uninitialized_move_n(other.data_.GetAddress(), other.size_, new_data.GetAddress());
+        data_.Swap(new_data);
+        size_ = other.size_;
+    }
 }
 
-template<typename T>
-inline Vector<T>& Vector<T>::operator=(Vector&& rhs) noexcept
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>& Vector<T, Allocator, GrowthPolicy>::operator=(Vector&& rhs) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+    || AllocTraits::is_always_equal::value)
 {
-    Swap(rhs);
+    InvalidateIterators();
+    rhs.InvalidateIterators();
+    if constexpr (AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+    {
+        SwapAllocatorsIf<typename AllocTraits::propagate_on_container_move_assignment>(data_.GetAllocator(), rhs.data_.GetAllocator());
+        data_.Swap(rhs.data_);
+        std::swap(size_, rhs.size_);
+    }
+    else if (data_.GetAllocator() == rhs.data_.GetAllocator())
+    {
+        data_.Swap(rhs.data_);
+        std::swap(size_, rhs.size_);
+    }
+    else
+    {
+        Vector rhs_moved(std::move(rhs), data_.GetAllocator());
+        data_.Swap(rhs_moved.data_);
+        std::swap(size_, rhs_moved.size_);
+    }
     return *this;
 }
 
-template<typename T>
-inline void Vector<T>::Swap(Vector& other) noexcept
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::Swap(Vector& other) noexcept
 {
+    SwapAllocatorsIf<typename AllocTraits::propagate_on_container_swap>(data_.GetAllocator(), other.data_.GetAllocator());
+    assert(data_.GetAllocator() == other.data_.GetAllocator());
+    InvalidateIterators();
+    other.InvalidateIterators();
     data_.Swap(other.data_);
     std::swap(size_, other.size_);
 }
 
-template<typename T>
-inline size_t Vector<T>::Size() const noexcept
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Allocator Vector<T, Allocator, GrowthPolicy>::GetAllocator() const noexcept
+{
+    return data_.GetAllocator();
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline size_t Vector<T, Allocator, GrowthPolicy>::Size() const noexcept
 {
     return size_;
 }
 
-template<typename T>
-inline size_t Vector<T>::Capacity() const noexcept
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline size_t Vector<T, Allocator, GrowthPolicy>::Capacity() const noexcept
 {
     return data_.Capacity();
 }
 
-template<typename T>
-inline void Vector<T>::Reserve(size_t new_capacity)
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline T* Vector<T, Allocator, GrowthPolicy>::Data() noexcept
 {
-    if (new_capacity <= data_.Capacity()) {
-        return;
-    }
-    RawMemory<T> new_data(new_capacity);
-    if constexpr (!std::is_copy_constructible_v<T> || std::is_nothrow_move_constructible_v<T>) {
-        std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
-    }
-    else
-    {
-        std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
-    }
-    std::destroy_n(data_.GetAddress(), size_);
-    data_.Swap(new_data);
+    return data_.GetAddress();
 }
 
-template<typename T>
-inline void Vector<T>::Resize(size_t new_size)
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline const T* Vector<T, Allocator, GrowthPolicy>::Data() const noexcept
 {
-    if (new_size <= size_)
-    {
-        for (size_t i = new_size; i < size_; i++)
-        {
-            Destroy(data_.GetAddress() + i);
-        }
-    }
-    else
-    {
-        Reserve(new_size);
-        std::uninitialized_value_construct(data_.GetAddress() + size_, data_.GetAddress() + new_size);
-    }
-	size_ = new_size;
+    return data_.GetAddress();
 }
 
-template<typename T>
-inline void Vector<T>::PushBack(const T& value)
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Span<T> Vector<T, Allocator, GrowthPolicy>::AsSpan() noexcept
 {
-    EmplaceBack(value);
+    return Span<T>(data_.GetAddress(), size_);
 }
 
-template<typename T>
-inline void Vector<T>::PushBack(T&& value)
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Span<const T> Vector<T, Allocator, GrowthPolicy>::AsSpan() const noexcept
 {
-    EmplaceBack(std::move(value));
+    return Span<const T>(data_.GetAddress(), size_);
 }
 
-template<typename T>
-inline void Vector<T>::PopBack()
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Span<T> Vector<T, Allocator, GrowthPolicy>::Subspan(size_t offset, size_t count) noexcept
 {
-    Destroy(data_ + size_ - 1);
-    --size_;
+    return AsSpan().Subspan(offset, count);
 }
 
-template<typename T>
-inline typename Vector<T>::iterator Vector<T>::Insert(const_iterator pos, const T& value)
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Span<const T> Vector<T, Allocator, GrowthPolicy>::Subspan(size_t offset, size_t count) const noexcept
 {
-    return Emplace(pos, value);
+    return AsSpan().Subspan(offset, count);
 }
 
-template<typename T>
-inline typename Vector<T>::iterator Vector<T>::Insert(const_iterator pos, T&& value)
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline ReleasedBuffer<T, Allocator> Vector<T, Allocator, GrowthPolicy>::Release() noexcept
 {
-    return Emplace(pos, std::move(value));
+    InvalidateIterators();
+    const size_t capacity = data_.Capacity();
+    return ReleasedBuffer<T, Allocator>{ data_.Release(), std::exchange(size_, 0), capacity,
+        BufferDeallocator<T, Allocator>(capacity, data_.GetAllocator()) };
 }
 
-template<typename T>
-inline typename Vector<T>::iterator Vector<T>::Erase(const_iterator pos)
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::Reserve(size_t new_capacity)
 {
-    size_t id = pos - begin();
-    Destroy(std::move(begin() + id + 1, end(), begin() + id));
-    --size_;
-    return data_ + (pos - begin());
+    if (new_capacity <= data_.Capacity()) {
+        return;
+    }
+    InvalidateIterators();
+    if (data_.TryExpand(new_capacity)) {
+        return;
+    }
+    Reallocate(new_capacity);
 }
 
-template<typename T>
-inline const T& Vector<T>::operator[](size_t index) const noexcept
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::ShrinkToFit()
 {
-    return const_cast<Vector&>(*this)[index];
+    if (data_.Capacity() == RawMemory<T, Allocator>::RoundCapacity(size_)) {
+        return;
+    }
+    InvalidateIterators();
+    if (size_ == 0) {
+        RawMemory<T, Allocator> empty(data_.GetAllocator());
+        data_.Swap(empty);
+        return;
+    }
+    Reallocate(size_);
 }
 
-template<typename T>
-inline T& Vector<T>::operator[](size_t index) noexcept
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline bool Vector<T, Allocator, GrowthPolicy>::Trim(double min_load)
 {
-    assert(index < size_);
-    return data_[index];
+    if (static_cast<double>(size_) >= static_cast<double>(data_.Capacity()) * min_load) {
+        return false;
+    }
+    ShrinkToFit();
+    return true;
 }
 
-template<typename T>
-inline Vector<T>::~Vector()
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::Clear() noexcept
 {
+    InvalidateIterators();
     DestroyN(data_.GetAddress(), size_);
+    size_ = 0;
 }
 
-template<typename T>
-inline void Vector<T>::DestroyN(T* buf, size_t n) noexcept
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::Resize(size_t new_size)
 {
-    for (size_t i = 0; i != n; ++i) {
-        Destroy(buf + i);
+    if (new_size <= size_)
+    {
+        InvalidateIterators();
+        for (size_t i = new_size; i < size_; i++)
+        {
+            Destroy(data_.GetAddress() + i);
+        }
+    }
+    else
+    {
+        Reserve(new_size);
+        std::uninitialized_value_construct(data_.GetAddress() + size_, data_.GetAddress() + new_size);
     }
+	size_ = new_size;
 }
 
-template<typename T>
-inline void Vector<T>::CopyConstruct(T* buf, const T& elem)
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::ResizeDefaultInit(size_t new_size)
 {
-    new (buf) T(elem);
+    if (new_size <= size_)
+    {
+        InvalidateIterators();
+        DestroyN(data_ + new_size, size_ - new_size);
+    }
+    else
+    {
+        Reserve(new_size);
+        std::uninitialized_default_construct(data_ + size_, data_ + new_size);
+    }
+    size_ = new_size;
 }
 
-template<typename T>
-inline void Vector<T>::MoveConstruct(T* buf, T&& elem)
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename Operation>
+inline void Vector<T, Allocator, GrowthPolicy>::ResizeAndOverwrite(size_t new_size, Operation op)
 {
-    new (buf) T(std::move(elem));
+    static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+        "Raw memory can be filled in place only for trivial types");
+    if (new_size <= size_)
+    {
+        InvalidateIterators();
+        size_ = new_size;
+        return;
+    }
+    Reserve(new_size);
+    const size_t count = new_size - size_;
+    const size_t written = op(data_ + size_, count);
+    assert(written <= count);
+    size_ += written;
 }
 
-template<typename T>
-inline void Vector<T>::Destroy(T* buf) noexcept
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::ParallelCopyFrom(const Vector& other)
 {
-    buf->~T();
+    if (this == &other)
+    {
+        return;
+    }
+    RawMemory<T, Allocator> new_data(other.size_, data_.GetAllocator());
+    T* dest = new_data.GetAddress();
+    detail::ParallelUninitialized(dest, other.size_, [dest, &other](size_t first, size_t last) {
+        std::uninitialized_copy_n(other.data_ + first, last - first, dest + first);
+    });
+    InvalidateIterators();
+    detail::ParallelDestroyN(data_.GetAddress(), size_);
+    data_.Swap(new_data);
+    size_ = other.size_;
 }
 
-template<typename T>
-template<typename ...Args>
-inline T& Vector<T>::EmplaceBack(Args&&... args)
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::ParallelResize(size_t new_size)
 {
-    if (size_ < Capacity())
+    if (new_size <= size_)
     {
-        new (data_ + size_) T(std::forward<Args>(args)...);
+        InvalidateIterators();
+        detail::ParallelDestroyN(data_ + new_size, size_ - new_size);
     }
     else
     {
-        RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-        new (new_data + size_) T(std::forward<Args>(args)...);
-        if constexpr (!std::is_copy_constructible_v<T> || std::is_nothrow_move_constructible_v<T>) {
-            for (size_t i = 0; i < size_; i++)
-            {
-                MoveConstruct(new_data + i, std::move(data_[i]));
-            }
+        Reserve(new_size);
+        T* tail = data_ + size_;
+        detail::ParallelUninitialized(tail, new_size - size_, [tail](size_t first, size_t last) {
+            std::uninitialized_value_construct_n(tail + first, last - first);
+        });
+    }
+    size_ = new_size;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::ParallelClear() noexcept
+{
+    InvalidateIterators();
+    detail::ParallelDestroyN(data_.GetAddress(), size_);
+    size_ = 0;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::PushBack(const T& value)
+{
+    EmplaceBack(value);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::PushBack(T&& value)
+{
+    EmplaceBack(std::move(value));
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::PopBack()
+{
+    detail::HardenedCheck(size_ != 0, "PopBack on empty Vector");
+    InvalidateIterators();
+    Destroy(data_ + size_ - 1);
+    --size_;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::Insert(const_iterator pos, const T& value)
+{
+    return Emplace(pos, value);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::Insert(const_iterator pos, T&& value)
+{
+    return Emplace(pos, std::move(value));
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::Insert(const_iterator pos, size_t count, const T& value)
+{
+    // value     ,    
+    const T copy(value);
+    return InsertN(IndexOf(pos), detail::RepeatIterator<T>(copy, 0), count);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename InputIt, typename>
+inline typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::Insert(const_iterator pos, InputIt first, InputIt last)
+{
+    if constexpr (detail::IsForwardIteratorV<InputIt>)
+    {
+        return InsertN(IndexOf(pos), first, static_cast<size_t>(std::distance(first, last)));
+    }
+    else
+    {
+        //    ,       
+        const size_t id = IndexOf(pos);
+        Vector tail(data_.GetAllocator());
+        tail.Append(first, last);
+        return InsertN(id, std::make_move_iterator(tail.Data()), tail.Size());
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename InputIt, typename>
+inline void Vector<T, Allocator, GrowthPolicy>::Append(InputIt first, InputIt last)
+{
+    if constexpr (detail::IsForwardIteratorV<InputIt>)
+    {
+        InsertN(size_, first, static_cast<size_t>(std::distance(first, last)));
+    }
+    else
+    {
+        for (; first != last; ++first)
+        {
+            EmplaceBack(*first);
+        }
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename InputIt, typename>
+inline void Vector<T, Allocator, GrowthPolicy>::Assign(InputIt first, InputIt last)
+{
+    if constexpr (detail::IsForwardIteratorV<InputIt>)
+    {
+        const size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count > data_.Capacity())
+        {
+            RawMemory<T, Allocator> new_data(count, data_.GetAllocator());
+            std::uninitialized_copy_n(first, count, new_data.GetAddress());
             DestroyN(data_.GetAddress(), size_);
+            data_.Swap(new_data);
+        }
+        else if (count <= size_)
+        {
+            std::copy_n(first, count, data_.GetAddress());
+            DestroyN(data_ + count, size_ - count);
+        }
+        else
+        {
+            InputIt mid = std::next(first, size_);
+            std::copy(first, mid, data_.GetAddress());
+            std::uninitialized_copy(mid, last, data_ + size_);
+        }
+        //       ,   
+        //    
+        InvalidateIterators();
+        size_ = count;
+    }
+    else
+    {
+        size_t i = 0;
+        for (; first != last && i < size_; ++first, ++i)
+        {
+            data_[i] = *first;
+        }
+        InvalidateIterators();
+        DestroyN(data_ + i, size_ - i);
+        size_ = i;
+        Append(first, last);
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::Assign(size_t count, const T& value)
+{
+    InvalidateIterators();
+    if (count > data_.Capacity())
+    {
+        RawMemory<T, Allocator> new_data(count, data_.GetAllocator());
+        detail::UninitializedFillN(new_data.GetAddress(), count, value);
+        DestroyN(data_.GetAddress(), size_);
+        data_.Swap(new_data);
+    }
+    else if (count <= size_)
+    {
+        // value    ,      
+        std::fill_n(data_.GetAddress(), count, value);
+        DestroyN(data_ + count, size_ - count);
+    }
+    else
+    {
+        std::fill_n(data_.GetAddress(), size_, value);
+        detail::UninitializedFillN(data_ + size_, count - size_, value);
+    }
+    size_ = count;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::Erase(const_iterator pos)
+{
+    const size_t id = IndexOf(pos);
+    detail::HardenedCheck(id < size_, "Erase position out of range");
+    InvalidateIterators();
+    Destroy(std::move(data_ + (id + 1), data_ + size_, data_ + id));
+    --size_;
+    return MakeIterator(id);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::Erase(const_iterator first, const_iterator last)
+{
+    const size_t id = IndexOf(first);
+    const size_t last_id = IndexOf(last);
+    detail::HardenedCheck(id <= last_id, "Erase range is reversed");
+    const size_t count = last_id - id;
+    if (count == 0)
+    {
+        return MakeIterator(id);
+    }
+    InvalidateIterators();
+    if constexpr (IsTriviallyRelocatableV<T>)
+    {
+        T* hole = data_ + id;
+        DestroyN(hole, count);
+        std::memmove(static_cast<void*>(hole), static_cast<const void*>(hole + count), (size_ - id - count) * sizeof(T));
+    }
+    else
+    {
+        std::move(data_ + (id + count), data_ + size_, data_ + id);
+        DestroyN(data_ + (size_ - count), count);
+    }
+    size_ -= count;
+    return MakeIterator(id);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::Find(const T& value)
+{
+    return MakeIterator(detail::FindValue(ActiveSimdLevel(), data_.GetAddress(), size_, value));
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy>::const_iterator Vector<T, Allocator, GrowthPolicy>::Find(const T& value) const
+{
+    return MakeIterator(detail::FindValue(ActiveSimdLevel(), data_.GetAddress(), size_, value));
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline size_t Vector<T, Allocator, GrowthPolicy>::Count(const T& value) const
+{
+    return detail::CountValue(ActiveSimdLevel(), data_.GetAddress(), size_, value);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline bool Vector<T, Allocator, GrowthPolicy>::Contains(const T& value) const
+{
+    return detail::FindValue(ActiveSimdLevel(), data_.GetAddress(), size_, value) != size_;
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline const T& Vector<T, Allocator, GrowthPolicy>::operator[](size_t index) const noexcept
+{
+    return const_cast<Vector&>(*this)[index];
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline T& Vector<T, Allocator, GrowthPolicy>::operator[](size_t index) noexcept
+{
+    assert(index < size_);
+    detail::HardenedCheck(index < size_, "Vector index out of range");
+    return data_[index];
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline const T& Vector<T, Allocator, GrowthPolicy>::At(size_t index) const
+{
+    return const_cast<Vector&>(*this).At(index);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline T& Vector<T, Allocator, GrowthPolicy>::At(size_t index)
+{
+    if (index >= size_)
+    {
+        throw std::out_of_range("Vector index out of range");
+    }
+    return data_[index];
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline Vector<T, Allocator, GrowthPolicy>::~Vector()
+{
+    DestroyN(data_.GetAddress(), size_);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::MakeIterator(size_t index) noexcept
+{
+    if constexpr (CHECKED_ITERATORS)
+    {
+        return iterator(data_ + index, this, IteratorGeneration());
+    }
+    else
+    {
+        return data_ + index;
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline typename Vector<T, Allocator, GrowthPolicy>::const_iterator Vector<T, Allocator, GrowthPolicy>::MakeIterator(size_t index) const noexcept
+{
+    if constexpr (CHECKED_ITERATORS)
+    {
+        return const_iterator(data_ + index, this, IteratorGeneration());
+    }
+    else
+    {
+        return data_ + index;
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline size_t Vector<T, Allocator, GrowthPolicy>::IndexOf(const_iterator pos) const noexcept
+{
+    const T* ptr;
+    if constexpr (CHECKED_ITERATORS)
+    {
+        detail::HardenedCheck(pos.IsValidFor(this), "invalidated or foreign iterator passed to Vector");
+        ptr = pos.Base();
+    }
+    else
+    {
+        ptr = pos;
+    }
+    detail::HardenedCheck(ptr >= data_.GetAddress() && ptr <= data_ + size_, "iterator does not point into Vector");
+    return static_cast<size_t>(ptr - data_.GetAddress());
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::InvalidateIterators() noexcept
+{
+    Invalidate();
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline uint64_t Vector<T, Allocator, GrowthPolicy>::IteratorGeneration() const noexcept
+{
+    return Generation();
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::DestroyN(T* buf, size_t n) noexcept
+{
+    for (size_t i = 0; i != n; ++i) {
+        Destroy(buf + i);
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::CopyConstruct(T* buf, const T& elem)
+{
+    new (buf) T(elem);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::MoveConstruct(T* buf, T&& elem)
+{
+    new (buf) T(std::move(elem));
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::Destroy(T* buf) noexcept
+{
+    buf->~T();
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline void Vector<T, Allocator, GrowthPolicy>::Reallocate(size_t new_capacity)
+{
+    assert(new_capacity >= size_);
+    InvalidateIterators();
+    if constexpr (IsTriviallyRelocatableV<T> && RawMemory<T, Allocator>::CAN_REALLOCATE) {
+        data_.Reallocate(new_capacity);
+        return;
+    }
+    RawMemory<T, Allocator> new_data(new_capacity, data_.GetAllocator());
+    detail::ParallelRelocateN(data_.GetAddress(), size_, new_data.GetAddress());
+    instrumentation::OnReallocate<T>(data_.Capacity(), new_data.Capacity());
+    data_.Swap(new_data);
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename ForwardIt>
+inline typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::InsertN(size_t id, ForwardIt first, size_t count)
+{
+    if (count == 0)
+    {
+        return MakeIterator(id);
+    }
+    InvalidateIterators();
+    const size_t tail_size = size_ - id;
+    if (size_ + count > data_.Capacity() && !data_.TryExpand(NextCapacity(size_ + count)))
+    {
+        //    ,       
+        RawMemory<T, Allocator> new_data(NextCapacity(size_ + count), data_.GetAllocator());
+        std::uninitialized_copy_n(first, count, new_data + id);
+        try
+        {
+            detail::ParallelUninitializedRelocateN(data_.GetAddress(), id, new_data.GetAddress());
+        }
+        catch (...)
+        {
+            DestroyN(new_data + id, count);
+            throw;
+        }
+        try
+        {
+            detail::ParallelUninitializedRelocateN(data_ + id, tail_size, new_data + (id + count));
+        }
+        catch (...)
+        {
+            DestroyN(new_data.GetAddress(), id + count);
+            throw;
+        }
+        detail::ParallelDestroyRelocatedN(data_.GetAddress(), size_);
+        instrumentation::OnReallocate<T>(data_.Capacity(), new_data.Capacity());
+        data_.Swap(new_data);
+        size_ += count;
+    }
+    else if constexpr (IsTriviallyRelocatableV<T>)
+    {
+        //    memmove,        
+        T* hole = data_ + id;
+        std::memmove(static_cast<void*>(hole + count), static_cast<const void*>(hole), tail_size * sizeof(T));
+        try
+        {
+            std::uninitialized_copy_n(first, count, hole);
+        }
+        catch (...)
+        {
+            std::memmove(static_cast<void*>(hole), static_cast<const void*>(hole + count), tail_size * sizeof(T));
+            throw;
+        }
+        size_ += count;
+    }
+    else
+    {
+        T* hole = data_ + id;
+        T* old_end = data_ + size_;
+        if (tail_size > count)
+        {
+            std::uninitialized_move_n(old_end - count, count, old_end);
+            size_ += count;
+            std::move_backward(hole, old_end - count, old_end);
+            std::copy_n(first, count, hole);
         }
         else
         {
-            for (size_t i = 0; i < size_; i++)
+            ForwardIt mid = std::next(first, tail_size);
+            std::uninitialized_copy_n(mid, count - tail_size, old_end);
+            try
             {
-                CopyConstruct(new_data + i, data_[i]);
+                std::uninitialized_move_n(hole, tail_size, hole + count);
             }
-            DestroyN(data_.GetAddress(), size_);
+            catch (...)
+            {
+                DestroyN(old_end, count - tail_size);
+                throw;
+            }
+            size_ += count;
+            std::copy_n(first, tail_size, hole);
         }
-        data_.Swap(new_data);
     }
-    ++size_;
-    return data_[size_ - 1];
+    return MakeIterator(id);
 }
 
-template<typename T>
+template<typename T, typename Allocator, typename GrowthPolicy>
 template<typename... Args>
-inline typename Vector<T>::iterator Vector<T>::Emplace(const_iterator pos, Args&&... args)
+inline void Vector<T, Allocator, GrowthPolicy>::EmplaceShift(size_t id, Args&&... args)
 {
-    iterator result_it;
-    size_t id = pos - begin();
-    if (size_ != Capacity())
+    T* target = data_ + id;
+    //   ,    ,     
+    const bool aliased = detail::AnyArgumentInRange(data_.GetAddress() + id, data_.GetAddress() + size_, args...);
+    if constexpr (IsTriviallyRelocatableV<T>)
     {
-        if (size_ > 0)
+        const size_t tail_bytes = (size_ - id) * sizeof(T);
+        if (!aliased)
         {
-            T obj(std::forward<Args>(args)...);
-            MoveConstruct(end(), std::move(*(end() - 1)));
-            if (id + 1 < size_)
+            //    memmove,       .
+            //    ,   
+            std::memmove(static_cast<void*>(target + 1), static_cast<const void*>(target), tail_bytes);
+            try
             {
-                std::move_backward(begin() + id, end() - 1, end());
-                data_[id] = std::move(obj);
+                new (target) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                std::memmove(static_cast<void*>(target), static_cast<const void*>(target + 1), tail_bytes);
+                throw;
             }
         }
         else
         {
-			new (data_ + id) T(std::forward<Args>(args)...);
+            alignas(T) unsigned char slot[sizeof(T)];
+            T* obj = new (slot) T(std::forward<Args>(args)...);
+            std::memmove(static_cast<void*>(target + 1), static_cast<const void*>(target), tail_bytes);
+            detail::RelocateN(obj, 1, target);
         }
-        
-        ++size_;
-        return begin() + id;
     }
     else
     {
-        RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-        new (new_data + id) T(std::forward<Args>(args)...);
-        result_it = new_data + id;
-        try
+        if constexpr (std::is_nothrow_constructible_v<T, Args&&...>)
         {
-            if constexpr (!std::is_copy_constructible_v<T> || std::is_nothrow_move_constructible_v<T>) {
-                for (size_t i = 0; i < id; i++)
+            if (!aliased)
+            {
+                //    ,     
+                //    
+                T* last = data_ + size_;
+                MoveConstruct(last, std::move(*(last - 1)));
+                try
                 {
-					MoveConstruct(new_data + i, std::move(data_[i]));
+                    std::move_backward(target, last - 1, last);
                 }
-            }
-            else
-            {
-                for (size_t i = 0; i < id; i++)
+                catch (...)
                 {
-                    CopyConstruct(new_data + i, data_[i]);
+                    Destroy(last);
+                    throw;
                 }
+                Destroy(target);
+                new (target) T(std::forward<Args>(args)...);
+                return;
             }
         }
+        T obj(std::forward<Args>(args)...);
+        T* last = data_ + size_;
+        MoveConstruct(last, std::move(*(last - 1)));
+        try
+        {
+            std::move_backward(target, last - 1, last);
+            *target = std::move(obj);
+        }
+        catch (...)
+        {
+            //         ,    
+            //  ;   ,     
+            Destroy(last);
+            throw;
+        }
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+inline size_t Vector<T, Allocator, GrowthPolicy>::NextCapacity(size_t required) const noexcept
+{
+    return GrowthPolicy::NextCapacity(data_.Capacity(), required, sizeof(T));
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename Propagate>
+inline void Vector<T, Allocator, GrowthPolicy>::SwapAllocatorsIf(Allocator& lhs, Allocator& rhs) noexcept
+{
+    if constexpr (Propagate::value)
+    {
+        using std::swap;
+        swap(lhs, rhs);
+    }
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename ...Args>
+inline T& Vector<T, Allocator, GrowthPolicy>::EmplaceBack(Args&&... args)
+{
+    if (size_ < Capacity())
+    {
+        new (data_ + size_) T(std::forward<Args>(args)...);
+    }
+    else if (const size_t new_capacity = NextCapacity(size_ + 1); data_.TryExpand(new_capacity))
+    {
+        InvalidateIterators();
+        new (data_ + size_) T(std::forward<Args>(args)...);
+    }
+    else if constexpr (IsTriviallyRelocatableV<T> && RawMemory<T, Allocator>::CAN_REALLOCATE)
+    {
+        InvalidateIterators();
+        //      ,     
+        alignas(T) unsigned char slot[sizeof(T)];
+        T* obj = new (slot) T(std::forward<Args>(args)...);
+        try
+        {
+            data_.Reallocate(new_capacity);
+        }
+        catch (...)
+        {
+            Destroy(obj);
+            throw;
+        }
+        detail::RelocateN(obj, 1, data_ + size_);
+    }
+    else
+    {
+        RawMemory<T, Allocator> new_data(new_capacity, data_.GetAllocator());
+        new (new_data + size_) T(std::forward<Args>(args)...);
+        try
+        {
+            detail::ParallelRelocateN(data_.GetAddress(), size_, new_data.GetAddress());
+        }
+        catch (...)
+        {
+            Destroy(new_data + size_);
+            throw;
+        }
+        InvalidateIterators();
+        instrumentation::OnReallocate<T>(data_.Capacity(), new_data.Capacity());
+        data_.Swap(new_data);
+    }
+    ++size_;
+    return data_[size_ - 1];
+}
+
+template<typename T, typename Allocator, typename GrowthPolicy>
+template<typename... Args>
+inline typename Vector<T, Allocator, GrowthPolicy>::iterator Vector<T, Allocator, GrowthPolicy>::Emplace(const_iterator pos, Args&&... args)
+{
+    const size_t id = IndexOf(pos);
+    const size_t new_capacity = NextCapacity(size_ + 1);
+    if (id != size_)
+    {
+        InvalidateIterators();
+    }
+    if (size_ != Capacity() || data_.TryExpand(new_capacity))
+    {
+        if (id == size_)
+        {
+            new (data_ + id) T(std::forward<Args>(args)...);
+        }
+        else
+        {
+            EmplaceShift(id, std::forward<Args>(args)...);
+        }
+
+        ++size_;
+        return MakeIterator(id);
+    }
+    else if constexpr (IsTriviallyRelocatableV<T> && RawMemory<T, Allocator>::CAN_REALLOCATE)
+    {
+        alignas(T) unsigned char slot[sizeof(T)];
+        T* obj = new (slot) T(std::forward<Args>(args)...);
+        try
+        {
+            data_.Reallocate(new_capacity);
+        }
+        catch (...)
+        {
+            Destroy(obj);
+            throw;
+        }
+        InvalidateIterators();
+        std::memmove(static_cast<void*>(data_ + (id + 1)), static_cast<const void*>(data_ + id), (size_ - id) * sizeof(T));
+        detail::RelocateN(obj, 1, data_ + id);
+        ++size_;
+        return MakeIterator(id);
+    }
+    else
+    {
+        RawMemory<T, Allocator> new_data(new_capacity, data_.GetAllocator());
+        new (new_data + id) T(std::forward<Args>(args)...);
+        try
+        {
+            detail::ParallelUninitializedRelocateN(data_.GetAddress(), id, new_data.GetAddress());
+        }
         catch (...)
         {
             Destroy(new_data + id);
+            throw;
+        }
+
+        try
+        {
+            detail::ParallelUninitializedRelocateN(data_ + id, size_ - id, new_data + (id + 1));
+        }
+        catch (...)
+        {
+            DestroyN(new_data.GetAddress(), id + 1);
+            throw;
         }
 
+        InvalidateIterators();
+        detail::ParallelDestroyRelocatedN(data_.GetAddress(), size_);
+        instrumentation::OnReallocate<T>(data_.Capacity(), new_data.Capacity());
+        data_.Swap(new_data);
+        ++size_;
+        return MakeIterator(id);
+    }
+}
+
+//      ,  ,    .
+//    .     ,
+//      
+template <typename T, typename Allocator, typename GrowthPolicy, typename Predicate>
+size_t EraseIf(Vector<T, Allocator, GrowthPolicy>& vector, Predicate pred)
+{
+    const size_t size = vector.size_;
+    vector.InvalidateIterators();
+    if constexpr (IsTriviallyRelocatableV<T>)
+    {
+        T* data = vector.data_.GetAddress();
+        size_t write = 0;
+        size_t read = 0;
         try
         {
-            if constexpr (!std::is_copy_constructible_v<T> || std::is_nothrow_move_constructible_v<T>) {
-                for (size_t i = id; i < size_; i++)
+            for (; read < size; ++read)
+            {
+                if (pred(std::as_const(data[read])))
                 {
-                    MoveConstruct(new_data + i + 1, std::move(data_[i]));
+                    Vector<T, Allocator, GrowthPolicy>::Destroy(data + read);
                 }
-            }
-            else
-            {
-                for (size_t i = id; i < size_; i++)
+                else
                 {
-                    CopyConstruct(new_data + i + 1, data_[i]);
+                    if (write != read)
+                    {
+                        std::memcpy(static_cast<void*>(data + write), static_cast<const void*>(data + read), sizeof(T));
+                    }
+                    ++write;
                 }
             }
         }
         catch (...)
         {
-            DestroyN(new_data.GetAddress(), id + 1);
+            //     ,      
+            std::memmove(static_cast<void*>(data + write), static_cast<const void*>(data + read), (size - read) * sizeof(T));
+            vector.size_ = write + (size - read);
+            throw;
         }
+        vector.size_ = write;
+        return size - write;
+    }
+    else
+    {
+        T* data = vector.data_.GetAddress();
+        T* new_end = std::remove_if(data, data + size, [&pred](const T& value) {
+            return pred(value);
+            });
+        vector.Erase(vector.begin() + (new_end - data), vector.end());
+        return size - vector.size_;
+    }
+}
 
-        DestroyN(begin(), size_);
-        data_.Swap(new_data);
-        ++size_;
-        return result_it;
+//   ,  value,    
+template <typename T, typename Allocator, typename GrowthPolicy, typename U>
+size_t EraseValue(Vector<T, Allocator, GrowthPolicy>& vector, const U& value)
+{
+    return EraseIf(vector, [&value](const T& elem) {
+        return elem == value;
+        });
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+bool operator==(const Vector<T, Allocator, GrowthPolicy>& lhs, const Vector<T, Allocator, GrowthPolicy>& rhs)
+{
+    return lhs.Size() == rhs.Size() && detail::MismatchIndex(ActiveSimdLevel(), lhs.Data(), rhs.Data(), lhs.Size()) == lhs.Size();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+bool operator!=(const Vector<T, Allocator, GrowthPolicy>& lhs, const Vector<T, Allocator, GrowthPolicy>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+//  .       
+//   
+template <typename T, typename Allocator, typename GrowthPolicy>
+bool operator<(const Vector<T, Allocator, GrowthPolicy>& lhs, const Vector<T, Allocator, GrowthPolicy>& rhs)
+{
+    if constexpr (IsBitwiseComparableV<T> && std::is_trivially_copyable_v<T>)
+    {
+        const size_t common = std::min(lhs.Size(), rhs.Size());
+        const size_t id = detail::MismatchIndex(ActiveSimdLevel(), lhs.Data(), rhs.Data(), common);
+        return id != common ? lhs[id] < rhs[id] : lhs.Size() < rhs.Size();
+    }
+    else
+    {
+        return std::lexicographical_compare(lhs.Data(), lhs.Data() + lhs.Size(), rhs.Data(), rhs.Data() + rhs.Size());
     }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+bool operator>(const Vector<T, Allocator, GrowthPolicy>& lhs, const Vector<T, Allocator, GrowthPolicy>& rhs)
+{
+    return rhs < lhs;
+}
 
-    return iterator();
+template <typename T, typename Allocator, typename GrowthPolicy>
+bool operator<=(const Vector<T, Allocator, GrowthPolicy>& lhs, const Vector<T, Allocator, GrowthPolicy>& rhs)
+{
+    return !(rhs < lhs);
 }
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+bool operator>=(const Vector<T, Allocator, GrowthPolicy>& lhs, const Vector<T, Allocator, GrowthPolicy>& rhs)
+{
+    return !(lhs < rhs);
+}
+
+namespace pmr {
+
+    // ,     std::pmr::memory_resource
+    template <typename T, typename GrowthPolicy = DoublingGrowth>
+    using Vector = ::Vector<T, std::pmr::polymorphic_allocator<T>, GrowthPolicy>;
+
+}  // namespace pmr